@@ -0,0 +1,213 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Laurens Ruijtenberg
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <optional>
+#include <print>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+/*
+ * A tiny benchmark harness, so measuring the cost of the safe wrappers doesn't need an external dependency.
+ * Benchmarks register themselves through a static bench::registrar and get the number of iterations to run.
+ * On Linux the retired instructions and cycles are counted as well, when the kernel allows perf events.
+ */
+namespace bench {
+
+    /* Prevents the compiler from optimizing away a value that is computed in a benchmark */
+    template<typename T>
+    inline void do_not_optimize(const T & value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void * sink;
+        sink = &value;
+#endif
+    }
+
+    /* Passed to every benchmark, counters are reported per iteration next to the timing */
+    struct state {
+        size_t iterations;
+        std::map<std::string, double> counters;
+        /* Set by a benchmark which times itself, e.g. to leave starting and joining threads out of the measurement */
+        std::optional<std::chrono::steady_clock::duration> elapsed;
+    };
+
+    struct benchmark {
+        std::string name;
+        std::function<void(state &)> body;
+    };
+
+    inline std::vector<benchmark> & registry() {
+        static std::vector<benchmark> benchmarks;
+        return benchmarks;
+    }
+
+    struct registrar {
+        registrar(std::string name, std::function<void(state &)> body) {
+            registry().push_back({ std::move(name), std::move(body) });
+        }
+    };
+
+    /* Counts hardware events of the calling thread, every counter is left out when it can't be opened */
+    class perf_counters {
+#if defined(__linux__)
+        struct event {
+            const char * name;
+            int fd;
+        };
+
+        std::vector<event> _events;
+
+        static int open_event(const uint64_t config) {
+            perf_event_attr attr {};
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = config;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+
+    public:
+        perf_counters() {
+            for (const auto & [name, config] : { std::pair { "instructions", PERF_COUNT_HW_INSTRUCTIONS }, std::pair { "cycles", PERF_COUNT_HW_CPU_CYCLES } }) {
+                if (const int fd = open_event(config); fd >= 0) {
+                    _events.push_back({ name, fd });
+                }
+            }
+        }
+
+        ~perf_counters() {
+            for (const auto & event : _events) {
+                close(event.fd);
+            }
+        }
+
+        perf_counters(const perf_counters &) = delete;
+        perf_counters & operator=(const perf_counters &) = delete;
+
+        void start() {
+            for (const auto & event : _events) {
+                ioctl(event.fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(event.fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+
+        void stop(std::map<std::string, double> & counters) {
+            for (const auto & event : _events) {
+                ioctl(event.fd, PERF_EVENT_IOC_DISABLE, 0);
+                uint64_t value = 0;
+                if (read(event.fd, &value, sizeof(value)) == sizeof(value)) {
+                    counters[event.name] = static_cast<double>(value);
+                }
+            }
+        }
+#else
+    public:
+        void start() {}
+        void stop(std::map<std::string, double> &) {}
+#endif
+    };
+
+    enum class output_format {
+        text,
+        json
+    };
+
+    inline std::string json_escape(const std::string & text) {
+        std::string escaped;
+        for (const char c : text) {
+            if (c == '"' || c == '\\') escaped += '\\';
+            escaped += c;
+        }
+        return escaped;
+    }
+
+    inline void run_all(const size_t iterations, const output_format format = output_format::text) {
+        perf_counters perf;
+        bool first = true;
+
+        if (format == output_format::json) {
+            std::print("{{\"iterations\":{},\"benchmarks\":[", iterations);
+        }
+
+        for (const auto & [name, body] : registry()) {
+            state warm_up { iterations / 10, {}, {} };
+            body(warm_up);
+
+            state measured { iterations, {}, {} };
+            perf.start();
+            const auto start = std::chrono::steady_clock::now();
+            body(measured);
+            const auto end = std::chrono::steady_clock::now();
+            const auto elapsed = measured.elapsed.value_or(end - start);
+            perf.stop(measured.counters);
+
+            const auto ns = std::chrono::duration<double, std::nano>(elapsed).count();
+            const auto per_op = [&](const double value) { return value / static_cast<double>(iterations); };
+
+            if (format == output_format::json) {
+                std::print("{}{{\"name\":\"{}\",\"ns_per_op\":{:.3f},\"counters_per_op\":{{", first ? "" : ",", json_escape(name), per_op(ns));
+                bool first_counter = true;
+                for (const auto & [counter, value] : measured.counters) {
+                    std::print("{}\"{}\":{:.3f}", first_counter ? "" : ",", json_escape(counter), per_op(value));
+                    first_counter = false;
+                }
+                std::print("}}}}");
+                first = false;
+                continue;
+            }
+
+            std::print("{:<48} {:>10.3f} ns/op", name, per_op(ns));
+            for (const auto & [counter, value] : measured.counters) {
+                std::print("  {:>8.3f} {}/op", per_op(value), counter);
+            }
+            std::print("\n");
+        }
+
+        if (format == output_format::json) {
+            std::print("]}}\n");
+        }
+    }
+}
+
+#endif //BENCH_HPP
@@ -0,0 +1,65 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Laurens Ruijtenberg
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+
+#include <numeric>
+#include <vector>
+
+#include "bench.hpp"
+
+import safe;
+
+namespace {
+    constexpr size_t element_count = 4096;
+
+    std::vector<int> make_numbers() {
+        std::vector<int> numbers(element_count);
+        std::iota(numbers.begin(), numbers.end(), 0);
+        return numbers;
+    }
+
+    bench::registrar raw_vector("index_ref/raw vector[i]", [](bench::state & state) {
+        const auto numbers = make_numbers();
+        for (size_t i = 0; i < state.iterations; ++i) {
+            bench::do_not_optimize(numbers[i % element_count]);
+        }
+    });
+
+    bench::registrar function_pointer("index_ref/function pointer index_ref<T>", [](bench::state & state) {
+        const auto numbers = make_numbers();
+        for (size_t i = 0; i < state.iterations; ++i) {
+            const safe::index_ref<int> ref(numbers, i % element_count);
+            bench::do_not_optimize(ref.value());
+        }
+    });
+
+    bench::registrar static_binding("index_ref/static static_index_ref<C>", [](bench::state & state) {
+        const auto numbers = make_numbers();
+        for (size_t i = 0; i < state.iterations; ++i) {
+            const safe::static_index_ref ref(numbers, i % element_count);
+            bench::do_not_optimize(ref.value());
+        }
+    });
+}
@@ -0,0 +1,179 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Laurens Ruijtenberg
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#include "bench.hpp"
+
+import safe;
+
+namespace {
+    constexpr size_t byte_count = 64 * 1024;
+    //the raw and the safe forms load and store the same uint32_t values at the same offsets, so only the check differs
+    constexpr size_t slot_count = byte_count / sizeof(uint32_t) - 1;
+
+    bench::registrar raw_load("memory/raw pointer load", [](bench::state & state) {
+        const auto bytes = std::make_unique<std::byte[]>(byte_count);
+        for (size_t i = 0; i < state.iterations; ++i) {
+            uint32_t value;
+            std::memcpy(&value, bytes.get() + (i % slot_count) * sizeof(uint32_t), sizeof(value));
+            bench::do_not_optimize(value);
+        }
+    });
+
+    bench::registrar checked_get("memory/get<T>", [](bench::state & state) {
+        const safe::memory bytes(byte_count);
+        for (size_t i = 0; i < state.iterations; ++i) {
+            bench::do_not_optimize(bytes.get<uint32_t>((i % slot_count) * sizeof(uint32_t)).value());
+        }
+    });
+
+    bench::registrar unchecked_get("memory/get<T, unsafe_unchecked>", [](bench::state & state) {
+        const safe::memory bytes(byte_count);
+        for (size_t i = 0; i < state.iterations; ++i) {
+            bench::do_not_optimize(bytes.get<uint32_t, safe::unsafe_unchecked>((i % slot_count) * sizeof(uint32_t)).value());
+        }
+    });
+
+    bench::registrar raw_store("memory/raw pointer store", [](bench::state & state) {
+        const auto bytes = std::make_unique<std::byte[]>(byte_count);
+        for (size_t i = 0; i < state.iterations; ++i) {
+            const auto value = static_cast<uint32_t>(i);
+            std::memcpy(bytes.get() + (i % slot_count) * sizeof(uint32_t), &value, sizeof(value));
+        }
+        bench::do_not_optimize(bytes[0]);
+    });
+
+    bench::registrar checked_set("memory/set<T>", [](bench::state & state) {
+        safe::memory bytes(byte_count);
+        for (size_t i = 0; i < state.iterations; ++i) {
+            bytes.set<uint32_t>(static_cast<uint32_t>(i), (i % slot_count) * sizeof(uint32_t));
+        }
+        bench::do_not_optimize(bytes.get<uint32_t>(0).value());
+    });
+
+    //a short-lived per-message header, which is where the inline buffer saves the allocation
+    constexpr size_t header_size = 64;
+
+    bench::registrar heap_header("memory/64 byte header, memory", [](bench::state & state) {
+        for (size_t i = 0; i < state.iterations; ++i) {
+            safe::memory header(header_size);
+            header.set<uint32_t>(static_cast<uint32_t>(i), 0);
+            header.set<uint16_t>(static_cast<uint16_t>(i), 8);
+            bench::do_not_optimize(header.get<uint32_t>(0).value());
+        }
+    });
+
+    bench::registrar inline_header("memory/64 byte header, inline_memory<64>", [](bench::state & state) {
+        for (size_t i = 0; i < state.iterations; ++i) {
+            safe::inline_memory<header_size> header(header_size);
+            header.set<uint32_t>(static_cast<uint32_t>(i), 0);
+            header.set<uint16_t>(static_cast<uint16_t>(i), 8);
+            bench::do_not_optimize(header.get<uint32_t>(0).value());
+        }
+    });
+
+    //random reads over a block much larger than the TLB reach of 4K pages
+    constexpr size_t large_byte_count = 256 * 1024 * 1024;
+
+    void random_reads(bench::state & state, const safe::memory & bytes) {
+        uint64_t index = 0;
+        for (size_t i = 0; i < state.iterations; ++i) {
+            index = (index * 6364136223846793005ull + 1442695040888963407ull);
+            bench::do_not_optimize(bytes.get<uint32_t>((index >> 20) % (large_byte_count - sizeof(uint64_t))).value());
+        }
+    }
+
+    bench::registrar standard_pages("memory/random get<T>, 256 MiB, standard pages", [](bench::state & state) {
+        random_reads(state, safe::memory(large_byte_count));
+    });
+
+    bench::registrar huge_pages("memory/random get<T>, 256 MiB, huge pages", [](bench::state & state) {
+        random_reads(state, safe::memory(large_byte_count, { .pages = safe::page_backing::huge }));
+    });
+
+    //bulk operations over a 4 KiB buffer, one op is the whole buffer
+    constexpr size_t buffer_size = 4096;
+    //get/set can't reach the last value of a block, so every variant leaves it out
+    constexpr size_t buffer_values = buffer_size / sizeof(uint32_t) - 1;
+
+    bench::registrar set_loop("memory/set<T> loop, 4 KiB", [](bench::state & state) {
+        safe::memory bytes(buffer_size);
+        for (size_t i = 0; i < state.iterations; ++i) {
+            for (size_t j = 0; j < buffer_values; ++j) {
+                bytes.set<uint32_t>(static_cast<uint32_t>(i), j * sizeof(uint32_t));
+            }
+            bench::do_not_optimize(bytes.get<uint32_t>(0).value());
+        }
+    });
+
+    bench::registrar fill("memory/fill<T>, 4 KiB", [](bench::state & state) {
+        safe::memory bytes(buffer_size);
+        for (size_t i = 0; i < state.iterations; ++i) {
+            bytes.fill<uint32_t>(static_cast<uint32_t>(i), 0, buffer_values);
+            bench::do_not_optimize(bytes.get<uint32_t>(0).value());
+        }
+    });
+
+    bench::registrar get_loop_find("memory/get<T> loop search, 4 KiB", [](bench::state & state) {
+        safe::memory bytes(buffer_size);
+        bytes.set<uint32_t>(1, buffer_size - sizeof(uint32_t) * 2);
+        for (size_t i = 0; i < state.iterations; ++i) {
+            size_t found = 0;
+            for (size_t j = 0; j < buffer_values; ++j) {
+                if (bytes.get<uint32_t>(j * sizeof(uint32_t)).value() == 1) {
+                    found = j;
+                    break;
+                }
+            }
+            bench::do_not_optimize(found);
+        }
+    });
+
+    bench::registrar find("memory/find<T>, 4 KiB", [](bench::state & state) {
+        safe::memory bytes(buffer_size);
+        bytes.set<uint32_t>(1, buffer_size - sizeof(uint32_t) * 2);
+        for (size_t i = 0; i < state.iterations; ++i) {
+            bench::do_not_optimize(bytes.find<uint32_t>(1, 0, buffer_values));
+        }
+    });
+
+    bench::registrar crc32c("memory/crc32c, 4 KiB", [](bench::state & state) {
+        const safe::memory bytes(buffer_size);
+        for (size_t i = 0; i < state.iterations; ++i) {
+            bench::do_not_optimize(bytes.crc32c(0, buffer_size));
+        }
+    });
+
+    bench::registrar xxhash64("memory/xxhash64, 4 KiB", [](bench::state & state) {
+        const safe::memory bytes(buffer_size);
+        for (size_t i = 0; i < state.iterations; ++i) {
+            bench::do_not_optimize(bytes.xxhash64(0, buffer_size));
+        }
+    });
+}
@@ -0,0 +1,90 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Laurens Ruijtenberg
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+
+#include <numeric>
+#include <vector>
+
+#include "bench.hpp"
+
+import safe;
+
+namespace {
+    constexpr size_t element_count = 4096;
+
+    struct point {
+        double x = 0;
+        double y = 0;
+    };
+
+    bench::registrar raw_scalar("owner/raw int", [](bench::state & state) {
+        int value = 0;
+        for (size_t i = 0; i < state.iterations; ++i) {
+            value = static_cast<int>(i);
+            bench::do_not_optimize(value);
+        }
+    });
+
+    bench::registrar owned_scalar("owner/owner<int>", [](bench::state & state) {
+        safe::owner<int> value;
+        for (size_t i = 0; i < state.iterations; ++i) {
+            value = static_cast<int>(i);
+            bench::do_not_optimize(value.value());
+        }
+    });
+
+    bench::registrar raw_struct("owner/raw struct member access", [](bench::state & state) {
+        point value;
+        for (size_t i = 0; i < state.iterations; ++i) {
+            value.x += 1.0;
+            bench::do_not_optimize(value.x);
+        }
+    });
+
+    bench::registrar owned_struct("owner/owner<struct> member access", [](bench::state & state) {
+        safe::owner<point> value;
+        for (size_t i = 0; i < state.iterations; ++i) {
+            value->x += 1.0;
+            bench::do_not_optimize(value->x);
+        }
+    });
+
+    bench::registrar raw_vector("owner/raw vector iteration", [](bench::state & state) {
+        std::vector<int> numbers(element_count);
+        std::iota(numbers.begin(), numbers.end(), 0);
+        for (size_t i = 0; i < state.iterations; ++i) {
+            bench::do_not_optimize(numbers[i % element_count]);
+        }
+    });
+
+    bench::registrar owned_vector("owner/owner<vector> iteration", [](bench::state & state) {
+        safe::owner<std::vector<int>> numbers;
+        numbers->resize(element_count);
+        std::iota(numbers->begin(), numbers->end(), 0);
+        for (size_t i = 0; i < state.iterations; ++i) {
+            bench::do_not_optimize(numbers->operator[](i % element_count));
+        }
+    });
+}
@@ -0,0 +1,62 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Laurens Ruijtenberg
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+
+#include "bench.hpp"
+
+import safe;
+
+namespace {
+    constexpr int range_size = 1000;
+
+    bench::registrar raw_int("ranged/unchecked int", [](bench::state & state) {
+        for (size_t i = 0; i < state.iterations; ++i) {
+            const int value = static_cast<int>(i % range_size);
+            bench::do_not_optimize(value);
+        }
+    });
+
+    bench::registrar checked_construction("ranged/ranged<int> construction", [](bench::state & state) {
+        for (size_t i = 0; i < state.iterations; ++i) {
+            const safe::ranged<int, 0, range_size - 1> value(static_cast<int>(i % range_size));
+            bench::do_not_optimize(value.value());
+        }
+    });
+
+    bench::registrar clamped_construction("ranged/ranged_clamped<int> construction", [](bench::state & state) {
+        for (size_t i = 0; i < state.iterations; ++i) {
+            const safe::ranged_clamped<int, 0, range_size / 2> value(static_cast<int>(i % range_size));
+            bench::do_not_optimize(static_cast<int>(value));
+        }
+    });
+
+    bench::registrar checked_arithmetic("ranged/ranged<int> addition without recheck", [](bench::state & state) {
+        const safe::ranged<int, 0, 10> step(1);
+        for (size_t i = 0; i < state.iterations; ++i) {
+            const safe::ranged<int, 0, range_size - 1> value(static_cast<int>(i % (range_size - 10)));
+            bench::do_not_optimize((value + step).value());
+        }
+    });
+}
@@ -0,0 +1,86 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Laurens Ruijtenberg
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+
+#include <numeric>
+#include <vector>
+
+#include "bench.hpp"
+
+import safe;
+
+namespace {
+    constexpr size_t element_count = 1024;
+
+    //the callees are kept out of line, so both variants pay for the same call and only the parameter type differs
+    [[gnu::noinline]] long sum_raw(const std::vector<int> & numbers) {
+        return std::accumulate(numbers.begin(), numbers.end(), 0L);
+    }
+
+    [[gnu::noinline]] long sum_safe(const safe::ref<std::vector<int>> & numbers) {
+        return std::accumulate(numbers->begin(), numbers->end(), 0L);
+    }
+
+    [[gnu::noinline]] void increment_raw(int & counter) {
+        counter = counter + 1;
+    }
+
+    [[gnu::noinline]] void increment_safe(safe::mut<int> counter) {
+        counter = counter.value() + 1;
+    }
+
+    bench::registrar raw_const_reference("ref/const T&", [](bench::state & state) {
+        std::vector<int> numbers(element_count);
+        std::iota(numbers.begin(), numbers.end(), 0);
+        for (size_t i = 0; i < state.iterations; ++i) {
+            bench::do_not_optimize(sum_raw(numbers));
+        }
+    });
+
+    bench::registrar safe_ref("ref/ref<T>", [](bench::state & state) {
+        safe::owner<std::vector<int>> numbers;
+        numbers->resize(element_count);
+        std::iota(numbers->begin(), numbers->end(), 0);
+        for (size_t i = 0; i < state.iterations; ++i) {
+            bench::do_not_optimize(sum_safe(numbers));
+        }
+    });
+
+    bench::registrar raw_reference("mut/T&", [](bench::state & state) {
+        int counter = 0;
+        for (size_t i = 0; i < state.iterations; ++i) {
+            increment_raw(counter);
+        }
+        bench::do_not_optimize(counter);
+    });
+
+    bench::registrar safe_mut("mut/mut<T>", [](bench::state & state) {
+        int counter = 0;
+        for (size_t i = 0; i < state.iterations; ++i) {
+            increment_safe(safe::mut<int>::create_from(counter));
+        }
+        bench::do_not_optimize(counter);
+    });
+}
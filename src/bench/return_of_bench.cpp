@@ -0,0 +1,108 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Laurens Ruijtenberg
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+
+#include <vector>
+
+#include "bench.hpp"
+
+import safe;
+
+namespace {
+    constexpr size_t payload_size = 1024;
+
+    /* A payload which counts how often it is copied and moved */
+    struct counting_payload {
+        static inline size_t copies = 0;
+        static inline size_t moves = 0;
+
+        std::vector<int> data;
+
+        counting_payload() = default;
+        counting_payload(const counting_payload & other) : data(other.data) { ++copies; }
+        counting_payload(counting_payload && other) noexcept : data(std::move(other.data)) { ++moves; }
+        counting_payload & operator=(const counting_payload & other) { data = other.data; ++copies; return *this; }
+        counting_payload & operator=(counting_payload && other) noexcept { data = std::move(other.data); ++moves; return *this; }
+
+        static void reset() {
+            copies = 0;
+            moves = 0;
+        }
+
+        static void report(bench::state & state) {
+            state.counters["copies"] = static_cast<double>(copies);
+            state.counters["moves"] = static_cast<double>(moves);
+        }
+    };
+
+    counting_payload make_plain() {
+        counting_payload payload;
+        payload.data.resize(payload_size);
+        return payload;
+    }
+
+    safe::return_of<counting_payload> make_safe() {
+        counting_payload payload;
+        payload.data.resize(payload_size);
+        return payload;
+    }
+
+    bench::registrar plain_return("return_of/plain return", [](bench::state & state) {
+        counting_payload::reset();
+        for (size_t i = 0; i < state.iterations; ++i) {
+            auto payload = make_plain();
+            bench::do_not_optimize(payload);
+        }
+        counting_payload::report(state);
+    });
+
+    bench::registrar consuming_owner("return_of/consuming owner()", [](bench::state & state) {
+        counting_payload::reset();
+        for (size_t i = 0; i < state.iterations; ++i) {
+            safe::owner<counting_payload> payload = make_safe().owner();
+            bench::do_not_optimize(payload);
+        }
+        counting_payload::report(state);
+    });
+
+    bench::registrar copying_owner("return_of/copying owner() on an lvalue", [](bench::state & state) {
+        counting_payload::reset();
+        for (size_t i = 0; i < state.iterations; ++i) {
+            const auto result = make_safe();
+            safe::owner<counting_payload> payload = result.owner();
+            bench::do_not_optimize(payload);
+        }
+        counting_payload::report(state);
+    });
+
+    bench::registrar consuming_value("return_of/consuming value()", [](bench::state & state) {
+        counting_payload::reset();
+        for (size_t i = 0; i < state.iterations; ++i) {
+            auto payload = make_safe().value();
+            bench::do_not_optimize(payload);
+        }
+        counting_payload::report(state);
+    });
+}
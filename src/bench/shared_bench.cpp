@@ -0,0 +1,73 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Laurens Ruijtenberg
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+
+
+#include <memory>
+
+#include "bench.hpp"
+
+import safe;
+
+namespace {
+    struct rules {
+        int threshold = 42;
+        int limit = 1000;
+    };
+
+    //libstdc++ skips the atomic instructions of std::shared_ptr until the process starts its first thread,
+    //so compare against a run where another benchmark (e.g. task_pool) already started threads
+    bench::registrar std_shared_copy("shared/std::shared_ptr copy and read", [](bench::state & state) {
+        const auto value = std::make_shared<rules>();
+        for (size_t i = 0; i < state.iterations; ++i) {
+            const auto copy = value;
+            bench::do_not_optimize(copy->threshold);
+        }
+    });
+
+    bench::registrar safe_shared_copy("shared/shared<T> copy and read", [](bench::state & state) {
+        const auto value = safe::shared<rules>::create();
+        for (size_t i = 0; i < state.iterations; ++i) {
+            const auto copy = value;
+            bench::do_not_optimize(copy->threshold);
+        }
+    });
+
+    bench::registrar single_thread_copy("shared/single_thread shared<T> copy and read", [](bench::state & state) {
+        const auto value = safe::shared<rules, safe::shared_mode::single_thread>::create();
+        for (size_t i = 0; i < state.iterations; ++i) {
+            const auto copy = value;
+            bench::do_not_optimize(copy->threshold);
+        }
+    });
+
+    bench::registrar borrowed_read("shared/ref() borrow and read", [](bench::state & state) {
+        const auto value = safe::shared<rules>::create();
+        for (size_t i = 0; i < state.iterations; ++i) {
+            const auto borrow = value.ref();
+            bench::do_not_optimize(borrow->threshold);
+        }
+    });
+}
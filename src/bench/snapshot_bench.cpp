@@ -0,0 +1,104 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Laurens Ruijtenberg
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+
+
+#include <array>
+#include <barrier>
+#include <chrono>
+#include <latch>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include "bench.hpp"
+
+import safe;
+
+namespace {
+    constexpr size_t reader_threads = 4;
+
+    struct config {
+        std::array<int, 16> limits {};
+    };
+
+    //splits the iterations over a number of reader threads, so ns/op is the inverse of the combined read throughput.
+    //The clock starts once all readers are running and stops when the last one is done, so starting and joining
+    //the threads isn't measured
+    template<typename Fn>
+    void read_concurrently(bench::state & state, Fn && read) {
+        std::barrier start(reader_threads + 1);
+        std::latch done(reader_threads);
+        std::vector<std::jthread> readers;
+        for (size_t t = 0; t < reader_threads; ++t) {
+            readers.emplace_back([&] {
+                start.arrive_and_wait();
+                for (size_t i = 0; i < state.iterations / reader_threads; ++i) {
+                    read(i);
+                }
+                done.count_down();
+            });
+        }
+        start.arrive_and_wait();
+        const auto begin = std::chrono::steady_clock::now();
+        done.wait();
+        state.elapsed = std::chrono::steady_clock::now() - begin;
+    }
+
+    bench::registrar shared_mutex_read("snapshot/shared_mutex read", [](bench::state & state) {
+        std::shared_mutex mutex;
+        const config value;
+        for (size_t i = 0; i < state.iterations; ++i) {
+            std::shared_lock lock(mutex);
+            bench::do_not_optimize(value.limits[i % 16]);
+        }
+    });
+
+    bench::registrar snapshot_read("snapshot/snapshot read", [](bench::state & state) {
+        const safe::snapshot<config> value { config {} };
+        for (size_t i = 0; i < state.iterations; ++i) {
+            const auto guard = value.read();
+            bench::do_not_optimize(guard->limits[i % 16]);
+        }
+    });
+
+    bench::registrar shared_mutex_threads("snapshot/shared_mutex read, 4 threads", [](bench::state & state) {
+        std::shared_mutex mutex;
+        const config value;
+        read_concurrently(state, [&](const size_t i) {
+            std::shared_lock lock(mutex);
+            bench::do_not_optimize(value.limits[i % 16]);
+        });
+    });
+
+    bench::registrar snapshot_threads("snapshot/snapshot read, 4 threads", [](bench::state & state) {
+        const safe::snapshot<config> value { config {} };
+        read_concurrently(state, [&](const size_t i) {
+            const auto guard = value.read();
+            bench::do_not_optimize(guard->limits[i % 16]);
+        });
+    });
+}
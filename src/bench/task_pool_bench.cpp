@@ -0,0 +1,66 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Laurens Ruijtenberg
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "bench.hpp"
+
+import safe;
+
+namespace {
+    std::atomic<size_t> completed = 0;
+
+    //the pool is started before and stopped after the clock runs, so starting and joining the workers isn't measured
+
+    bench::registrar detached_tasks("task_pool/submit detached task", [](bench::state & state) {
+        safe::task_pool pool;
+        completed = 0;
+        const auto begin = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < state.iterations; ++i) {
+            pool.submit([] { completed.fetch_add(1, std::memory_order_relaxed); });
+        }
+        while (completed.load(std::memory_order_relaxed) != state.iterations) {
+            std::this_thread::yield();
+        }
+        state.elapsed = std::chrono::steady_clock::now() - begin;
+    });
+
+    bench::registrar scoped_tasks("task_pool/spawn in scope", [](bench::state & state) {
+        safe::task_pool pool;
+        std::atomic<size_t> counter = 0;
+        const auto begin = std::chrono::steady_clock::now();
+        pool.scope([&](safe::task_scope & scope) {
+            for (size_t i = 0; i < state.iterations; ++i) {
+                scope.spawn([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+            }
+        });
+        state.elapsed = std::chrono::steady_clock::now() - begin;
+        bench::do_not_optimize(counter.load());
+    });
+}
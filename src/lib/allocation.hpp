@@ -0,0 +1,220 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Laurens Ruijtenberg
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+#ifndef ALLOCATION_HPP
+#define ALLOCATION_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+
+#include "check.hpp"
+
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+namespace safe {
+
+    /* The pages a memory block is backed with */
+    enum class page_backing {
+        /* Regular pages from the heap */
+        standard,
+        /* Blocks of at least huge_page_size are aligned to a huge page and marked with madvise(MADV_HUGEPAGE), so the
+         * kernel can back them with transparent huge pages. Ignored where the platform doesn't support it. */
+        transparent_huge,
+        /* Blocks are mapped from the reserved huge page pool (MAP_HUGETLB, or MEM_LARGE_PAGES on Windows). When no
+         * huge pages are available the allocation falls back to transparent_huge. */
+        huge
+    };
+
+    /* The transparent huge page size of x86-64 and of ARM with 4K base pages */
+    inline constexpr size_t huge_page_size = 2 * 1024 * 1024;
+
+    /**
+     * How a memory block is allocated, e.g. memory_options { .alignment = 64, .pages = page_backing::transparent_huge }.
+     */
+    struct memory_options {
+        /* The alignment of the start of the block in bytes, a power of two. Use page_size() for page alignment */
+        size_t alignment = alignof(std::max_align_t);
+        page_backing pages = page_backing::standard;
+    };
+
+    /**
+     * @return The size of a regular page of the operating system in bytes.
+     */
+    [[nodiscard]] inline size_t page_size() {
+#if defined(_WIN32)
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return static_cast<size_t>(info.dwPageSize);
+#else
+        static const auto size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        return size;
+#endif
+    }
+
+    /**
+     * @return The size of the pages in the reserved huge page pool which page_backing::huge maps from. That's
+     * Hugepagesize from /proc/meminfo on Linux, which isn't 2 MiB everywhere (ARM with 64K base pages uses 512 MiB),
+     * and GetLargePageMinimum() on Windows. Falls back to huge_page_size when the platform doesn't report one.
+     */
+    [[nodiscard]] inline size_t reserved_huge_page_size() {
+#if defined(_WIN32)
+        static const auto size = GetLargePageMinimum() != 0 ? static_cast<size_t>(GetLargePageMinimum()) : huge_page_size;
+        return size;
+#elif defined(__linux__)
+        static const auto size = [] {
+            size_t kilobytes = 0;
+            if (std::FILE * file = std::fopen("/proc/meminfo", "r"); file != nullptr) {
+                char line[128];
+                while (std::fgets(line, sizeof(line), file) != nullptr) {
+                    if (std::sscanf(line, "Hugepagesize: %zu kB", &kilobytes) == 1) break;
+                }
+                std::fclose(file);
+            }
+            return kilobytes != 0 ? kilobytes * 1024 : huge_page_size;
+        }();
+        return size;
+#else
+        return huge_page_size;
+#endif
+    }
+
+    namespace detail {
+        enum class block_kind : uint8_t {
+            array,
+            aligned,
+            mapped
+        };
+
+        /* Frees a block the same way it was allocated, it travels with the unique_ptr so moves keep working.
+         * It also remembers the backing that was asked for, so a copy of the block is allocated the same way. */
+        struct block_deleter {
+            block_kind kind = block_kind::array;
+            page_backing pages = page_backing::standard;
+            page_backing requested = page_backing::standard;
+            size_t alignment = alignof(std::max_align_t);
+            size_t length = 0;
+
+            void operator()(std::byte * ptr) const noexcept {
+                switch (kind) {
+                    case block_kind::array:
+                        delete[] ptr;
+                        break;
+                    case block_kind::aligned:
+                        ::operator delete(ptr, std::align_val_t { alignment });
+                        break;
+                    case block_kind::mapped:
+#if defined(_WIN32)
+                        VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+                        munmap(ptr, length);
+#endif
+                        break;
+                }
+            }
+        };
+
+        using block_ptr = std::unique_ptr<std::byte[], block_deleter>;
+
+        constexpr size_t round_up(const size_t value, const size_t multiple) {
+            return (value + multiple - 1) / multiple * multiple;
+        }
+
+        inline block_ptr allocate_mapped_huge(const size_t size) {
+            //mmap and munmap of MAP_HUGETLB need a multiple of the pool's page size, which isn't always 2 MiB
+            const auto page = reserved_huge_page_size();
+            const auto length = round_up(size, page);
+#if defined(_WIN32)
+            //large pages need the SeLockMemoryPrivilege, without it the allocation fails and we fall back
+            if (GetLargePageMinimum() == 0) return nullptr;
+            auto * mapped = VirtualAlloc(nullptr, length, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+            if (mapped == nullptr) return nullptr;
+#elif defined(MAP_HUGETLB)
+            auto * mapped = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (mapped == MAP_FAILED) return nullptr;
+#else
+            (void)length;
+            return nullptr;
+#endif
+            //anonymous mappings are zeroed by the kernel
+            return block_ptr(static_cast<std::byte *>(mapped), block_deleter { block_kind::mapped, page_backing::huge, page_backing::huge, page, length });
+        }
+
+        /**
+         * Allocates a zeroed block of memory.
+         * @param size The size of the block in bytes.
+         * @param options The alignment and the pages the block should be backed with.
+         * @throws std::invalid_argument if the alignment is not a power of two, an empty block is returned when the
+         * check policy doesn't throw.
+         */
+        template<typename Policy = default_check>
+        block_ptr allocate_block(const size_t size, const memory_options options) {
+            if (!check_always<std::invalid_argument, Policy>(std::has_single_bit(options.alignment), "Alignment must be a power of two")) [[unlikely]] {
+                return block_ptr(nullptr, block_deleter {});
+            }
+
+            if (options.pages == page_backing::huge && size > 0) {
+                if (auto block = allocate_mapped_huge(size); block != nullptr) {
+                    return block;
+                }
+            }
+
+            const bool huge = options.pages != page_backing::standard && size >= huge_page_size;
+            const auto alignment = huge ? std::max(options.alignment, huge_page_size) : options.alignment;
+            if (alignment <= alignof(std::max_align_t)) {
+                return block_ptr(new std::byte[size](), block_deleter { .requested = options.pages });
+            }
+
+            //the length is a multiple of the huge page, so madvise covers the whole block and nothing beyond it
+            const auto length = huge ? round_up(size, huge_page_size) : size;
+            auto * ptr = static_cast<std::byte *>(::operator new(length, std::align_val_t { alignment }));
+            block_ptr block(ptr, block_deleter { block_kind::aligned, page_backing::standard, options.pages, alignment, length });
+#if defined(MADV_HUGEPAGE)
+            //advise before zeroing, otherwise the first touch already faults the block in as regular pages
+            if (huge && madvise(ptr, length, MADV_HUGEPAGE) == 0) {
+                block.get_deleter().pages = page_backing::transparent_huge;
+            }
+#endif
+            std::memset(ptr, 0, length);
+            return block;
+        }
+    }
+}
+
+#endif //ALLOCATION_HPP
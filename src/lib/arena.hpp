@@ -0,0 +1,329 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Laurens Ruijtenberg
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "check.hpp"
+#include "returnof.hpp"
+
+namespace safe {
+
+    /**
+     * Describes what an arena does with the bytes it hands out. Zeroed is the default and
+     * behaves like safe::memory. Skipping the zeroing is faster, but a view can then observe
+     * data from a previous allocation, so it has to be an explicit (unsafe named) choice.
+     */
+    enum class arena_fill {
+        zeroed,
+        unsafe_uninitialized
+    };
+
+    class arena;
+
+    namespace detail {
+        /* The generation of an arena, shared with its views so it outlives the arena. The arena bumps it
+         * on every reset and when it's destroyed, which invalidates all the views it handed out. The arena and
+         * every view hold a reference; the count is a plain integer because an arena and its views are only
+         * used from one thread, so copying a view doesn't cost an atomic operation. */
+        struct arena_state {
+            size_t generation = 0;
+            size_t references = 1;
+        };
+
+        inline void release(arena_state * state) {
+            if (state != nullptr && --state->references == 0) {
+                delete state;
+            }
+        }
+    }
+
+    /**
+     * A non-owning, bounds-checked view on a block of bytes that was carved out of a safe::arena.
+     * It offers the same get/set/span API as safe::memory. On top of the bounds check it also
+     * verifies that the arena was not reset or destroyed since the view was handed out, so a stale
+     * view can never read or write the memory of a newer allocation or of a freed arena.
+     */
+    class arena_memory {
+        friend class arena;
+
+        detail::arena_state * _state = nullptr;
+        std::byte * _ptr = nullptr;
+        size_t _size = 0;
+        size_t _generation = 0;
+
+        arena_memory(detail::arena_state * state, std::byte * ptr, const size_t size, const size_t generation)
+            : _state(state), _ptr(ptr), _size(size), _generation(generation) {
+            if (_state != nullptr) ++_state->references;
+        }
+
+        constexpr bool is_safe_region(const size_t offset, const size_t length) const {
+            return detail::region_fits(_size, offset, length);
+        }
+
+        template<typename T, typename Policy>
+        T * get_pointer(const size_t offset) const;
+
+    public:
+        template<typename T>
+        constexpr bool is_safe_index(const size_t offset) const {
+            return (offset + sizeof(T)) < _size;
+        }
+
+        /* Views are cheap to copy, the memory itself is owned by the arena. A copy shares the arena's generation */
+        arena_memory(const arena_memory &other) : arena_memory(other._state, other._ptr, other._size, other._generation) {}
+
+        arena_memory(arena_memory &&other) noexcept
+            : _state(std::exchange(other._state, nullptr)), _ptr(other._ptr), _size(other._size), _generation(other._generation) {}
+
+        arena_memory & operator=(const arena_memory &other) {
+            if (other._state != nullptr) ++other._state->references;
+            detail::release(_state);
+            _state = other._state;
+            _ptr = other._ptr;
+            _size = other._size;
+            _generation = other._generation;
+            return *this;
+        }
+
+        arena_memory & operator=(arena_memory &&other) noexcept {
+            if (this != &other) {
+                detail::release(_state);
+                _state = std::exchange(other._state, nullptr);
+                _ptr = other._ptr;
+                _size = other._size;
+                _generation = other._generation;
+            }
+            return *this;
+        }
+
+        ~arena_memory() {
+            detail::release(_state);
+        }
+
+        /**
+         * @return True if the arena was not reset or destroyed since this view was handed out.
+         */
+        [[nodiscard]] bool is_valid() const;
+
+        /**
+         *
+         * @return The size of the memory block in bytes.
+         */
+        [[nodiscard]] constexpr size_t size() const { return _size; }
+
+        /**
+         * @note T must be a fundamental type or a POD (Plain Old Data) type
+         * @return A value copy of type T at the given offset.
+         */
+        template<typename T, typename Policy = default_check> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof(T) < sizeof(uintptr_t))
+        [[nodiscard]] constexpr return_of<T> get(const size_t offset) const {
+            return *get_pointer<T, Policy>(offset);
+        }
+
+        /**
+         *
+         * @tparam T The type of the value to get.
+         * @param offset The offset in bytes from the start of the memory block. The data offset will be checked to ensure it is within bounds.
+         * @note T must be a fundamental type or a POD (Plain Old Data) type.
+         * @return A pointer to type T at the given offset.
+         */
+        template<typename T, typename Policy = default_check> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof(T) >= sizeof(uintptr_t))
+        [[nodiscard]] constexpr return_of<ref<T>> get(const size_t offset) const {
+            return *get_pointer<T, Policy>(offset);
+        }
+
+        /**
+         *
+         * @tparam T The type of the value to set.
+         * @param value The value to store at the given offset.
+         * @param offset The offset in bytes from the start of the memory block. The data offset will be checked to ensure it is within bounds.
+         */
+        template<typename T, typename Policy = default_check> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof(T) < sizeof(uintptr_t))
+        constexpr void set(const T value, const size_t offset) {
+            *get_pointer<T, Policy>(offset) = value;
+        }
+
+        /**
+         *
+         * @tparam T The type of the value to set.
+         * @param value The value to store at the given offset.
+         * @param offset The offset in bytes from the start of the memory block. The data offset will be checked to ensure it is within bounds.
+         */
+        template<typename T, typename Policy = default_check> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof(T) >= sizeof(uintptr_t))
+        constexpr void set(const T & value, const size_t offset) {
+            *get_pointer<T, Policy>(offset) = value;
+        }
+
+        /**
+         *
+         * @tparam T The type of the value to set.
+         * @param value The value to store at the given offset.
+         * @param offset The offset in bytes from the start of the memory block. The data offset will be checked to ensure it is within bounds.
+         */
+        template<typename T, typename Policy = default_check> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof(T) >= sizeof(uintptr_t))
+        constexpr void set(const T * value, const size_t offset) {
+            *get_pointer<T, Policy>(offset) = *value;
+        }
+
+        /**
+         * Returns a span of type T starting at the given offset and with the given count.
+         * @tparam T The type of the elements in the span.
+         * @param offset The offset in bytes from the start of the memory block. The data offset will be checked to ensure it is within bounds.
+         * @param count The number of elements of type T in the span.
+         * @returns A span of type T starting at the given offset and with the given count.
+         */
+        template<typename T, typename Policy = default_check> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof(T) < sizeof(uintptr_t))
+        [[nodiscard]] constexpr return_of<const std::span<T>> span(const size_t offset, const size_t count) const {
+            if (!check<std::out_of_range, Policy>(is_valid(), "Arena memory was reset", check_site::memory_access)) [[unlikely]] {
+                return std::span<T>();
+            }
+            //the whole span has to be within the view
+            if (!check<std::out_of_range, Policy>(detail::span_fits<T>(_size, offset, count), "Offset is out of bounds", check_site::memory_access)) [[unlikely]] {
+                return std::span<T>();
+            }
+            return std::span<T>(reinterpret_cast<T *>(_ptr + offset), count);
+        }
+    };
+
+    /**
+     * An arena owns one big block of memory and hands out bounds-checked arena_memory views on it
+     * through bump allocation. Handing out a view costs a couple of additions, and releasing all of
+     * them is a single O(1) reset(). This makes it a good fit for per-request scratch buffers that
+     * would otherwise each do their own heap allocation.
+     *
+     * The arena is neither copyable nor movable, because every view it handed out refers back to it.
+     * Views may outlive the arena, they share its generation and become invalid once it's destroyed.
+     * An arena and its views belong to one thread: neither the generation nor its reference count is
+     * synchronized, which keeps handing out and copying views free of atomic operations.
+     */
+    class arena {
+        std::unique_ptr<std::byte[]> _ptr = nullptr;
+        size_t _size = 0;
+        size_t _used = 0;
+        detail::arena_state * _state = new detail::arena_state();
+        arena_fill _fill = arena_fill::zeroed;
+
+        [[nodiscard]] static constexpr size_t align_up(const size_t value, const size_t alignment) {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+    public:
+        /**
+         * Initializes an arena with the given capacity.
+         * @param size The capacity of the arena in bytes.
+         * @param fill Whether the bytes of every allocation are zeroed or left as they are.
+         */
+        explicit arena(const size_t size, const arena_fill fill = arena_fill::zeroed)
+            : _ptr(std::make_unique_for_overwrite<std::byte[]>(size)), _size(size), _fill(fill) {}
+
+        ~arena() {
+            ++_state->generation;
+            detail::release(_state);
+        }
+
+        arena(const arena &other) = delete;
+        arena(arena &&other) noexcept = delete;
+        arena & operator=(const arena &other) = delete;
+        arena & operator=(arena &&other) noexcept = delete;
+
+        /**
+         * @return The capacity of the arena in bytes.
+         */
+        [[nodiscard]] constexpr size_t size() const { return _size; }
+
+        /**
+         * @return The number of bytes handed out since the last reset, including alignment padding.
+         */
+        [[nodiscard]] constexpr size_t used() const { return _used; }
+
+        /**
+         * @return True if a block of the given size and alignment still fits in the arena.
+         */
+        [[nodiscard]] constexpr bool can_allocate(const size_t size, const size_t alignment = alignof(std::max_align_t)) const {
+            const auto start = align_up(reinterpret_cast<uintptr_t>(_ptr.get()) + _used, alignment) - reinterpret_cast<uintptr_t>(_ptr.get());
+            return start <= _size && size <= _size - start;
+        }
+
+        /**
+         * Carves a new block out of the arena.
+         * @param size The size of the block in bytes.
+         * @param alignment The alignment of the start of the block, must be a power of two.
+         * @throws std::bad_alloc if the arena doesn't have enough space left. When the check policy continues,
+         * the returned view is empty and never valid.
+         * @return A bounds-checked view on the new block.
+         */
+        template<typename Policy = default_check>
+        [[nodiscard]] arena_memory allocate(const size_t size, const size_t alignment = alignof(std::max_align_t)) {
+            if (!check_always<std::bad_alloc, Policy>(can_allocate(size, alignment), "Arena is full")) [[unlikely]] {
+                return arena_memory(nullptr, nullptr, 0, 0);
+            }
+
+            const auto base = reinterpret_cast<uintptr_t>(_ptr.get());
+            const auto start = align_up(base + _used, alignment) - base;
+            _used = start + size;
+
+            if (_fill == arena_fill::zeroed) {
+                std::memset(_ptr.get() + start, 0, size);
+            }
+
+            return arena_memory(_state, _ptr.get() + start, size, _state->generation);
+        }
+
+        /**
+         * Releases every block that was handed out in O(1). Views that were handed out
+         * before the reset become invalid and no longer give access to the memory.
+         */
+        void reset() {
+            _used = 0;
+            ++_state->generation;
+        }
+    };
+
+    template<typename T, typename Policy>
+    T * arena_memory::get_pointer(const size_t offset) const {
+        /* Same bounds check as safe::memory, extended with the arena generation */
+        if (!check<std::out_of_range, Policy>(detail::fits<T>(_size, offset) && is_valid(), "Offset is out of bounds", check_site::memory_access)) [[unlikely]] {
+            return detail::check_fallback<T>();
+        }
+        return reinterpret_cast<T *>(_ptr + offset);
+    }
+
+    inline bool arena_memory::is_valid() const {
+        return _state != nullptr && _generation == _state->generation;
+    }
+}
+
+#endif //ARENA_HPP
@@ -25,17 +25,23 @@
 #ifndef ASSERT_HPP
 #define ASSERT_HPP
 
-#include <cstdlib>
-#include <iostream>
 #include <cassert>
+#include <stdexcept>
+
+#include "check.hpp"
 
 namespace safe {
+    /**
+     * Asserts that the condition holds. Debug builds use assert, other builds hand a failed condition to the
+     * check policy, so it traps, aborts, throws std::logic_error or logs depending on SAFE_CHECK_POLICY.
+     * @tparam Policy The check policy, default_check when not given.
+     */
+    template<typename Policy = default_check>
     constexpr void safe_assert(const bool condition, const char * message) {
 #ifdef SAFE_DEBUG
-        assert(condition &&  message);
+        assert(condition && message);
 #else
-        std::cerr << "FATAL - Assertion failed: " << message << std::endl;
-        std::abort();
+        (void) check<std::logic_error, Policy>(condition, message, check_site::safe_assert);
 #endif
     }
 }
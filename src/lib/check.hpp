@@ -0,0 +1,231 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Laurens Ruijtenberg
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+#ifndef CHECK_HPP
+#define CHECK_HPP
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+
+#include "telemetry.hpp"
+
+/*
+ * The check policy decides what happens when a safety check fails. The library wide default is selected with the
+ * SAFE_CHECK_POLICY CMake option on the safelib target, which defines one of the SAFE_CHECK_POLICY_* macros below.
+ * Without any of them a failed check throws, or aborts when exceptions are disabled.
+ */
+#if (defined(__GNUC__) || defined(__clang__))
+    #define SAFE_COLD [[gnu::cold, gnu::noinline]]
+#elif defined(_MSC_VER)
+    #define SAFE_COLD __declspec(noinline)
+#else
+    #define SAFE_COLD
+#endif
+
+namespace safe {
+
+    enum class check_mode {
+        /* Stops the program with a trap instruction, the smallest possible failure path */
+        trap,
+        /* Prints the message to stderr and aborts */
+        abort,
+        /* Throws the exception type of the check, e.g. std::out_of_range */
+        throw_exception,
+        /* Prints the message to stderr and continues with a safe fallback (reads give zero, writes are dropped) */
+        log_and_continue,
+        /* Doesn't check at all. Only meant for audited hot paths, the name makes every use easy to find */
+        unsafe_unchecked
+    };
+
+#if defined(SAFE_CHECK_POLICY_TRAP)
+    inline constexpr check_mode default_check_mode = check_mode::trap;
+#elif defined(SAFE_CHECK_POLICY_ABORT)
+    inline constexpr check_mode default_check_mode = check_mode::abort;
+#elif defined(SAFE_CHECK_POLICY_LOG)
+    inline constexpr check_mode default_check_mode = check_mode::log_and_continue;
+#elif defined(SAFE_CHECK_POLICY_UNSAFE_UNCHECKED)
+    inline constexpr check_mode default_check_mode = check_mode::unsafe_unchecked;
+#elif defined(SAFE_CHECK_POLICY_THROW)
+#if !defined(__cpp_exceptions) && !defined(_CPPUNWIND)
+#error "SAFE_CHECK_POLICY_THROW needs exceptions, pick another SAFE_CHECK_POLICY when building with exceptions disabled"
+#endif
+    inline constexpr check_mode default_check_mode = check_mode::throw_exception;
+#elif defined(__cpp_exceptions) || defined(_CPPUNWIND)
+    inline constexpr check_mode default_check_mode = check_mode::throw_exception;
+#else
+    inline constexpr check_mode default_check_mode = check_mode::abort;
+#endif
+
+    namespace detail {
+        [[noreturn]] SAFE_COLD inline void check_trap() {
+#if (defined(__GNUC__) || defined(__clang__))
+            __builtin_trap();
+#else
+            std::abort();
+#endif
+        }
+
+        SAFE_COLD inline void check_log(const char * message) {
+            std::fputs("safe: check failed: ", stderr);
+            std::fputs(message, stderr);
+            std::fputc('\n', stderr);
+        }
+
+        [[noreturn]] SAFE_COLD inline void check_abort(const char * message) {
+            check_log(message);
+            std::abort();
+        }
+
+        /* Extra arguments go in front of the message, e.g. the error code and category of a std::system_error */
+        template<typename Exception, typename... Args>
+        [[noreturn]] SAFE_COLD void check_throw(const char * message, const Args &... args) {
+#if defined(__cpp_exceptions) || defined(_CPPUNWIND)
+            if constexpr (sizeof...(Args) > 0) throw Exception(args..., message);
+            else if constexpr (std::is_constructible_v<Exception, const char *>) throw Exception(message);
+            else throw Exception();
+#else
+            check_abort(message);
+#endif
+        }
+
+        /* Backing storage for log_and_continue, failed reads read zero from it and failed writes end up in it */
+        template<typename T>
+        SAFE_COLD T * check_fallback() {
+            alignas(T) thread_local std::byte storage[sizeof(T)];
+            std::memset(storage, 0, sizeof(T));
+            return reinterpret_cast<T *>(storage);
+        }
+
+        /* The value a function which returns T by value continues with after a failed check. Types which
+         * can't be default constructed have no safe fallback, so the check aborts instead */
+        template<typename T>
+        SAFE_COLD T check_fallback_value(const char * message) {
+            if constexpr (std::is_default_constructible_v<T>) {
+                return T {};
+            } else {
+                check_abort(message);
+            }
+        }
+
+        /* The bounds every block type checks against, so memory, inline_memory, mapped_memory and arena_memory
+         * agree on what fits. A value or region may end exactly at the end of the block, and the comparisons are
+         * written so a huge offset or length can't wrap around. */
+        template<typename T>
+        [[nodiscard]] constexpr bool fits(const size_t size, const size_t offset) {
+            return sizeof(T) <= size && offset <= size - sizeof(T);
+        }
+
+        [[nodiscard]] constexpr bool region_fits(const size_t size, const size_t offset, const size_t length) {
+            return offset <= size && length <= size - offset;
+        }
+
+        //count elements of T, count is checked first so count * sizeof(T) can't wrap around
+        template<typename T>
+        [[nodiscard]] constexpr bool span_fits(const size_t size, const size_t offset, const size_t count) {
+            return count <= size / sizeof(T) && region_fits(size, offset, count * sizeof(T));
+        }
+    }
+
+    /**
+     * A compile-time check policy. The types in the library take it as a template parameter that defaults to
+     * default_check, so a single call site can opt into a different mode than the rest of the program.
+     * @tparam Mode What happens when a check fails.
+     */
+    template<check_mode Mode>
+    struct check_policy {
+        static constexpr check_mode mode = Mode;
+        static constexpr bool enabled = Mode != check_mode::unsafe_unchecked;
+
+        /**
+         * Handles a failed check. The failure path is outlined and marked cold, so the checked fast path stays small.
+         * @tparam Exception The exception type which is thrown in throw_exception mode.
+         * @param message A static description of the failure.
+         * @param args Extra constructor arguments of the exception, which are passed in front of the message.
+         * @note Only returns in log_and_continue mode, the caller then has to continue with a safe fallback.
+         */
+        template<typename Exception, typename... Args>
+        static constexpr void fail(const char * message, const Args &... args) {
+            if constexpr (Mode == check_mode::trap) detail::check_trap();
+            else if constexpr (Mode == check_mode::abort) detail::check_abort(message);
+            else if constexpr (Mode == check_mode::throw_exception) detail::check_throw<Exception>(message, args...);
+            else if constexpr (Mode == check_mode::log_and_continue) detail::check_log(message);
+            else detail::check_abort(message);
+        }
+    };
+
+    using default_check = check_policy<default_check_mode>;
+    using trap_check = check_policy<check_mode::trap>;
+    using abort_check = check_policy<check_mode::abort>;
+    using throw_check = check_policy<check_mode::throw_exception>;
+    using log_check = check_policy<check_mode::log_and_continue>;
+    using unsafe_unchecked = check_policy<check_mode::unsafe_unchecked>;
+
+    /**
+     * Runs a check through the given policy.
+     * @tparam Exception The exception type which is thrown in throw_exception mode.
+     * @tparam Policy The check policy, default_check when not given.
+     * @param condition The condition which has to hold.
+     * @param message A static description of the failure.
+     * @param site Where the check is done, for the telemetry counters.
+     * @return True if the operation may continue, false if the check failed and the caller has to use its fallback.
+     */
+    template<typename Exception, typename Policy = default_check>
+    [[nodiscard]] constexpr bool check(const bool condition, const char * message, const check_site site = check_site::other) {
+        if constexpr (!Policy::enabled) {
+            return true;
+        } else {
+            detail::telemetry_record_check(site, condition);
+            if (condition) [[likely]] {
+                return true;
+            }
+            Policy::template fail<Exception>(message);
+            return false;
+        }
+    }
+
+    /**
+     * Runs a check which can't be turned off, for failures which aren't a bounds check on a hot path but an
+     * error the program has to handle, like a full container or a failing system call. It goes through the policy
+     * like check(), except that unsafe_unchecked aborts, there is no fast path to save by skipping it.
+     * @tparam Exception The exception type which is thrown in throw_exception mode.
+     * @param args Extra constructor arguments of the exception which go in front of the message, e.g. errno and
+     * std::system_category() for a std::system_error.
+     * @return True if the operation may continue, false if the check failed and the caller has to use its fallback.
+     */
+    template<typename Exception, typename Policy = default_check, typename... Args>
+    [[nodiscard]] constexpr bool check_always(const bool condition, const char * message, const check_site site = check_site::other, const Args &... args) {
+        detail::telemetry_record_check(site, condition);
+        if (condition) [[likely]] {
+            return true;
+        }
+        Policy::template fail<Exception>(message, args...);
+        return false;
+    }
+}
+
+#endif //CHECK_HPP
@@ -0,0 +1,333 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Laurens Ruijtenberg
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+#ifndef CURSOR_HPP
+#define CURSOR_HPP
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "check.hpp"
+#include "inline_memory.hpp"
+#include "memory.hpp"
+
+namespace safe {
+
+    namespace detail {
+        template<typename T>
+        concept wire_type = std::is_trivially_copyable_v<T> && (std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_pod_v<T>);
+
+        /* Converts between the host byte order and the given byte order, only integral and enum types are swapped */
+        template<std::endian Order, typename T>
+        [[nodiscard]] constexpr T convert_byte_order(const T value) {
+            if constexpr (Order == std::endian::native || sizeof(T) == 1) {
+                return value;
+            } else if constexpr (std::is_integral_v<T>) {
+                return std::byteswap(value);
+            } else if constexpr (std::is_enum_v<T>) {
+                return static_cast<T>(std::byteswap(static_cast<std::underlying_type_t<T>>(value)));
+            } else if constexpr (std::is_floating_point_v<T>) {
+                using bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+                return std::bit_cast<T>(std::byteswap(std::bit_cast<bits>(value)));
+            } else {
+                static_assert(Order == std::endian::native, "Only arithmetic and enum types can be converted to another byte order.");
+                return value;
+            }
+        }
+
+        constexpr size_t max_varint_size = 10;
+    }
+
+    /**
+     * A cursor which reads typed values one after the other from a block of memory. Every read checks that the
+     * value fits in the remaining bytes, a failed check goes through the check policy (std::out_of_range by default).
+     * Multi-byte values can be read in an explicit byte order and integers can be read as LEB128 varints.
+     */
+    class reader {
+        const std::byte * _data;
+        size_t _size;
+        size_t _position = 0;
+
+        template<typename Policy = default_check>
+        [[nodiscard]] bool require(const size_t length) const {
+            return check<std::out_of_range, Policy>(length <= _size - _position, "Read is out of bounds", check_site::memory_access);
+        }
+
+    public:
+        explicit reader(const std::span<const std::byte> data) : _data(data.data()), _size(data.size()) {}
+        explicit reader(const memory & data) : _data(data._ptr.get()), _size(data.size()) {}
+        template<size_t N>
+        explicit reader(const inline_memory<N> & data) : _data(data.data()), _size(data.size()) {}
+
+        [[nodiscard]] constexpr size_t position() const { return _position; }
+        [[nodiscard]] constexpr size_t remaining() const { return _size - _position; }
+
+        /**
+         * Reads a value and moves the cursor past it. When the check policy continues after a failed bounds check
+         * the value is zero and the cursor stays where it is.
+         * @tparam T The type of the value.
+         * @tparam Order The byte order in which the value is stored.
+         */
+        template<detail::wire_type T, std::endian Order = std::endian::native, typename Policy = default_check>
+        [[nodiscard]] T read() {
+            if (!require<Policy>(sizeof(T))) [[unlikely]] {
+                return T {};
+            }
+            T value;
+            std::memcpy(&value, _data + _position, sizeof(T));
+            _position += sizeof(T);
+            return detail::convert_byte_order<Order>(value);
+        }
+
+        /**
+         * Reads several values which follow each other, with a single bounds check for all of them.
+         * @return A tuple with the values in the order of the types.
+         */
+        template<std::endian Order = std::endian::native, detail::wire_type... Ts>
+        [[nodiscard]] std::tuple<Ts...> read_all() {
+            std::tuple<Ts...> values {};
+            if (!require((sizeof(Ts) + ... + 0))) [[unlikely]] {
+                return values;
+            }
+            std::apply([this](auto &... value) {
+                ((std::memcpy(&value, _data + _position, sizeof(value)),
+                  value = detail::convert_byte_order<Order>(value),
+                  _position += sizeof(value)), ...);
+            }, values);
+            return values;
+        }
+
+        /**
+         * Reads an unsigned LEB128 varint.
+         * @throws std::out_of_range if the varint runs past the end of the memory.
+         * @throws std::overflow_error if the varint doesn't fit in 64 bits.
+         */
+        [[nodiscard]] uint64_t read_varint() {
+            uint64_t result = 0;
+            for (size_t i = 0; i < detail::max_varint_size; ++i) {
+                if (!require(1)) [[unlikely]] {
+                    return 0;
+                }
+                const auto byte = static_cast<uint8_t>(_data[_position++]);
+                if (i == detail::max_varint_size - 1 && byte > 1) {
+                    break;
+                }
+                result |= static_cast<uint64_t>(byte & 0x7f) << (7 * i);
+                if ((byte & 0x80) == 0) {
+                    return result;
+                }
+            }
+            (void) check_always<std::overflow_error>(false, "Varint doesn't fit in 64 bits", check_site::memory_access);
+            return 0;
+        }
+
+        /**
+         * Reads a signed, zigzag encoded LEB128 varint.
+         */
+        [[nodiscard]] int64_t read_signed_varint() {
+            const auto value = read_varint();
+            return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+        }
+
+        /**
+         * Moves the cursor forward without reading.
+         */
+        void skip(const size_t length) {
+            if (!require(length)) [[unlikely]] {
+                return;
+            }
+            _position += length;
+        }
+    };
+
+    class writer;
+
+    /**
+     * A part of a writer's memory with a fixed layout of fields, validated in one go by writer::reserve(). The
+     * offset of every field is known at compile time and the whole layout fits in the reserved bytes, so the
+     * writes into the region have no bounds checks at all and still can't leave it. The fields can be written in
+     * any order, e.g. a header which is only filled in after the payload behind it was written.
+     * @tparam Ts The types of the fields, in the order in which they are laid out.
+     */
+    template<detail::wire_type... Ts>
+    class writer_region {
+        friend class writer;
+
+        std::byte * _data;
+
+        template<size_t I>
+        static constexpr size_t offset = [] {
+            constexpr size_t sizes[] = {sizeof(Ts)...};
+            size_t result = 0;
+            for (size_t i = 0; i < I; ++i) result += sizes[i];
+            return result;
+        }();
+
+        explicit writer_region(std::byte * data) : _data(data) {}
+
+    public:
+        writer_region(const writer_region & other) = delete;
+        writer_region & operator=(const writer_region & other) = delete;
+
+        [[nodiscard]] static constexpr size_t size() { return (sizeof(Ts) + ...); }
+
+        /**
+         * Writes the field at index I, an index outside of the layout doesn't compile.
+         * @tparam I The index of the field.
+         * @tparam Order The byte order in which the value is stored.
+         */
+        template<size_t I, std::endian Order = std::endian::native>
+        void write(const std::tuple_element_t<I, std::tuple<Ts...>> value) {
+            const auto converted = detail::convert_byte_order<Order>(value);
+            std::memcpy(_data + offset<I>, &converted, sizeof(converted));
+        }
+
+        /**
+         * Writes all fields in the order of the layout.
+         */
+        template<std::endian Order = std::endian::native>
+        void write_all(const Ts... values) {
+            [&]<size_t... Is>(std::index_sequence<Is...>) {
+                (write<Is, Order>(values), ...);
+            }(std::index_sequence_for<Ts...>{});
+        }
+    };
+
+    /**
+     * A cursor which writes typed values one after the other into a block of memory. Every write checks that the
+     * value fits in the remaining bytes, a failed check goes through the check policy (std::out_of_range by default).
+     * To write a lot of fixed size fields, reserve() validates a region with a fixed layout of fields once, the
+     * writes into it aren't checked any more.
+     */
+    class writer {
+        std::byte * _data;
+        size_t _size;
+        size_t _position = 0;
+
+        template<typename Policy = default_check>
+        [[nodiscard]] bool require(const size_t length) const {
+            return check<std::out_of_range, Policy>(length <= _size - _position, "Write is out of bounds", check_site::memory_access);
+        }
+
+    public:
+        explicit writer(const std::span<std::byte> data) : _data(data.data()), _size(data.size()) {}
+        explicit writer(memory & data) : _data(data._ptr.get()), _size(data.size()) {}
+        template<size_t N>
+        explicit writer(inline_memory<N> & data) : _data(data.data()), _size(data.size()) {}
+
+        [[nodiscard]] constexpr size_t position() const { return _position; }
+        [[nodiscard]] constexpr size_t remaining() const { return _size - _position; }
+
+        /**
+         * Writes a value and moves the cursor past it. When the check policy continues after a failed bounds check
+         * nothing is written.
+         * @tparam T The type of the value.
+         * @tparam Order The byte order in which the value is stored.
+         */
+        template<detail::wire_type T, std::endian Order = std::endian::native, typename Policy = default_check>
+        void write(const T value) {
+            if (!require<Policy>(sizeof(T))) [[unlikely]] {
+                return;
+            }
+            const auto converted = detail::convert_byte_order<Order>(value);
+            std::memcpy(_data + _position, &converted, sizeof(T));
+            _position += sizeof(T);
+        }
+
+        /**
+         * Writes several values after each other, with a single bounds check for all of them.
+         */
+        template<std::endian Order = std::endian::native, detail::wire_type... Ts>
+        void write_all(const Ts... values) {
+            if (!require((sizeof(Ts) + ... + 0))) [[unlikely]] {
+                return;
+            }
+            ((write_unchecked<Order>(values)), ...);
+        }
+
+        /**
+         * Writes an unsigned LEB128 varint.
+         */
+        void write_varint(uint64_t value) {
+            std::byte buffer[detail::max_varint_size];
+            size_t length = 0;
+            do {
+                auto byte = static_cast<uint8_t>(value & 0x7f);
+                value >>= 7;
+                if (value != 0) byte |= 0x80;
+                buffer[length++] = static_cast<std::byte>(byte);
+            } while (value != 0);
+
+            if (!require(length)) [[unlikely]] {
+                return;
+            }
+            std::memcpy(_data + _position, buffer, length);
+            _position += length;
+        }
+
+        /**
+         * Writes a signed, zigzag encoded LEB128 varint.
+         */
+        void write_signed_varint(const int64_t value) {
+            write_varint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+        }
+
+        /**
+         * Validates the bytes of a layout of fields in one go and moves the cursor past them.
+         * @tparam Ts The types of the fields, in the order in which they are laid out.
+         * @throws std::out_of_range if the fields don't fit in the remaining bytes.
+         * @return A region in which the fields can be written without further bounds checks. When the check policy
+         * continues after a failed check, the region writes into a scratch buffer and the cursor stays where it is.
+         */
+        template<detail::wire_type... Ts> requires (sizeof...(Ts) > 0)
+        [[nodiscard]] writer_region<Ts...> reserve() {
+            constexpr auto length = writer_region<Ts...>::size();
+            if (!require(length)) [[unlikely]] {
+                return writer_region<Ts...>(detail::check_fallback<std::array<std::byte, length>>()->data());
+            }
+            const auto start = _position;
+            _position += length;
+            return writer_region<Ts...>(_data + start);
+        }
+
+    private:
+        template<std::endian Order, typename T>
+        void write_unchecked(const T value) {
+            const auto converted = detail::convert_byte_order<Order>(value);
+            std::memcpy(_data + _position, &converted, sizeof(T));
+            _position += sizeof(T);
+        }
+    };
+}
+
+#endif //CURSOR_HPP
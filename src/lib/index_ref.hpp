@@ -9,8 +9,12 @@
 #include <iterator>
 #include <vector>
 #include <array>
+#include <stdexcept>
 
 #include "ptr.hpp"
+#include "result.hpp"
+#include "check.hpp"
+#include "telemetry.hpp"
 
 namespace safe {
 
@@ -122,15 +126,98 @@ namespace safe {
         index_ref(const ref_ptr<Container>& container, size_t index)
             : index_ref(*container.unsafe_pointer(), index) {}
 
+        template<typename Policy = default_check>
         [[nodiscard]] T value() const {
-            if (!is_valid()) {
-                throw std::out_of_range("Invalid index reference");
+            if (!check<std::out_of_range, Policy>(_is_valid(_ptr, _index), "Invalid index reference", check_site::index_ref_value)) [[unlikely]] {
+                return detail::check_fallback_value<T>("Invalid index reference");
+            }
+            return _get_value(_ptr, _index);
+        }
+
+        /**
+         * The non-throwing counterpart of value().
+         * @return A copy of the referenced element, or error_code::out_of_bounds if the index is no longer valid.
+         */
+        [[nodiscard]] result<T, error_code> try_value() const {
+            if (!valid_for(check_site::index_ref_value)) [[unlikely]] {
+                return failure(error_code::out_of_bounds);
             }
             return _get_value(_ptr, _index);
         }
 
         [[nodiscard]] bool is_valid() const {
-            return _is_valid(_ptr, _index);
+            return valid_for(check_site::index_ref_is_valid);
+        }
+
+    private:
+        [[nodiscard]] bool valid_for(const check_site site) const {
+            const bool valid = _is_valid(_ptr, _index);
+            detail::telemetry_record_check(site, valid);
+            return valid;
+        }
+    };
+
+    /*
+     * static_index_ref is the statically typed counterpart of index_ref. Because the container type
+     * is part of the type, value() and is_valid() are resolved at compile time and can be inlined
+     * (and for fixed size containers like std::array the size check can even be folded away).
+     * Use index_ref<T> (see type_erased()) where the container type can't be part of the signature,
+     * for example on ABI boundaries.
+     */
+    template<typename Container> requires indexed_container_of<Container, typename Container::value_type>
+    class static_index_ref {
+    public:
+        using value_type = typename Container::value_type;
+    private:
+        const Container* _container;
+        size_t _index;
+    public:
+        constexpr static_index_ref(const Container& container, size_t index) noexcept
+            : _container(&container)
+            , _index(index) {}
+
+        constexpr static_index_ref(const ref_ptr<Container>& container, size_t index)
+            : static_index_ref(*container.unsafe_pointer(), index) {}
+
+        // Allow moves (for optimizing on return), copies are not allowed, same as index_ref
+        constexpr static_index_ref(static_index_ref&& other) noexcept = default;
+        constexpr static_index_ref& operator=(static_index_ref&& other) noexcept = default;
+
+        template<typename Policy = default_check>
+        [[nodiscard]] constexpr value_type value() const {
+            if (!check<std::out_of_range, Policy>(_container != nullptr && _index < _container->size(), "Invalid index reference", check_site::index_ref_value)) [[unlikely]] {
+                return detail::check_fallback_value<value_type>("Invalid index reference");
+            }
+            return (*_container)[_index];
+        }
+
+        /**
+         * The non-throwing counterpart of value().
+         * @return A copy of the referenced element, or error_code::out_of_bounds if the index is no longer valid.
+         */
+        [[nodiscard]] constexpr result<value_type, error_code> try_value() const {
+            if (!valid_for(check_site::index_ref_value)) [[unlikely]] {
+                return failure(error_code::out_of_bounds);
+            }
+            return (*_container)[_index];
+        }
+
+        [[nodiscard]] constexpr bool is_valid() const {
+            return valid_for(check_site::index_ref_is_valid);
+        }
+
+        /**
+         * @return An index_ref to the same element which hides the container type behind function pointers.
+         */
+        [[nodiscard]] index_ref<value_type> type_erased() const {
+            return index_ref<value_type>(*_container, _index);
+        }
+
+    private:
+        [[nodiscard]] constexpr bool valid_for(const check_site site) const {
+            const bool valid = _container != nullptr && _index < _container->size();
+            detail::telemetry_record_check(site, valid);
+            return valid;
         }
     };
 }
@@ -0,0 +1,343 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Laurens Ruijtenberg
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef INLINE_MEMORY_HPP
+#define INLINE_MEMORY_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+#include "check.hpp"
+#include "layout.hpp"
+#include "result.hpp"
+#include "returnof.hpp"
+#include "simd.hpp"
+
+namespace safe {
+
+    /**
+     * A safe::memory with a small buffer optimization. Blocks of up to N bytes are stored inside the
+     * object itself, so creating one doesn't allocate and the bytes share a cache line with the object
+     * that owns them. Larger blocks fall back to the heap. It has the same bounds-checked get/set/span
+     * API and the same copy and move semantics as safe::memory.
+     * @tparam N The number of bytes which are stored inline.
+     */
+    template<size_t N>
+    class inline_memory {
+        static_assert(N > 0, "An inline_memory without inline bytes is a safe::memory.");
+
+        friend class reader;
+        friend class writer;
+
+        alignas(std::max_align_t) std::array<std::byte, N> _inline {};
+        std::unique_ptr<std::byte[]> _heap = nullptr;
+        size_t _size = 0;
+
+        //the heap pointer is only set beyond N bytes, so this compiles to a test and a conditional move
+        [[nodiscard]] constexpr std::byte * data() const {
+            return _heap != nullptr ? _heap.get() : const_cast<std::byte *>(_inline.data());
+        }
+
+        template<typename T, typename Policy>
+        constexpr T * get_pointer(const size_t offset) const {
+            if (!check<std::out_of_range, Policy>(is_safe_batch<T>(offset), "Offset is out of bounds", check_site::memory_access)) [[unlikely]] {
+                return detail::check_fallback<T>();
+            }
+            return reinterpret_cast<T *>(data() + offset);
+        }
+
+        template<typename T>
+        constexpr bool is_safe_batch(const size_t max_offset) const {
+            return detail::fits<T>(_size, max_offset);
+        }
+
+        constexpr bool is_safe_region(const size_t offset, const size_t length) const {
+            return detail::region_fits(_size, offset, length);
+        }
+
+        void assign(const std::byte * bytes, const size_t size) {
+            if (size > N) {
+                _heap = std::make_unique<std::byte[]>(size);
+            } else {
+                _heap.reset();
+            }
+            _size = size;
+            std::memcpy(data(), bytes, size);
+        }
+
+        constexpr void release() {
+            _heap.reset();
+            _size = 0;
+        }
+
+    public:
+        /**
+         * Initializes a zeroed memory block with the given size.
+         * @param size The size of the memory block in bytes. Up to N bytes are stored inline, a larger block is allocated on the heap.
+         */
+        constexpr inline_memory(const size_t size) : _size(size) {
+            if (size > N) {
+                _heap = std::make_unique<std::byte[]>(size);
+            }
+        }
+
+        inline_memory(const inline_memory & other) {
+            assign(other.data(), other._size);
+        }
+
+        inline_memory & operator=(const inline_memory & other) {
+            if (&other == this) return *this;
+            assign(other.data(), other._size);
+            return *this;
+        }
+
+        //an inline block can't be stolen, so moving it copies the (at most N) bytes
+        inline_memory(inline_memory && other) noexcept : _heap(std::move(other._heap)), _size(other._size) {
+            if (_heap == nullptr) {
+                std::memcpy(_inline.data(), other._inline.data(), _size);
+            }
+            other.release();
+        }
+
+        inline_memory & operator=(inline_memory && other) noexcept {
+            if (&other == this) return *this;
+            _heap = std::move(other._heap);
+            _size = other._size;
+            if (_heap == nullptr) {
+                std::memcpy(_inline.data(), other._inline.data(), _size);
+            }
+            other.release();
+            return *this;
+        }
+
+        /**
+         * @return The size of the memory block in bytes.
+         */
+        [[nodiscard]] constexpr size_t size() const { return _size; }
+
+        /**
+         * @return The number of bytes which can be stored without a heap allocation.
+         */
+        [[nodiscard]] static constexpr size_t inline_capacity() { return N; }
+
+        /**
+         * @return True when the bytes are stored inside the object, false when they live on the heap.
+         */
+        [[nodiscard]] constexpr bool is_inline() const { return _heap == nullptr; }
+
+        /**
+         * @note T must be a fundamental type or a POD (Plain Old Data) type
+         * @return A value copy of type T at the given offset.
+         */
+        template<typename T, typename Policy = default_check> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof(T) < sizeof(uintptr_t))
+        [[nodiscard]] constexpr return_of<T> get(const size_t offset) const {
+            return *get_pointer<T, Policy>(offset);
+        }
+
+        /**
+         * @tparam T The type of the value to get.
+         * @param offset The offset in bytes from the start of the memory block. The data offset will be checked to ensure it is within bounds.
+         * @return A reference to type T at the given offset.
+         */
+        template<typename T, typename Policy = default_check> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof(T) >= sizeof(uintptr_t))
+        [[nodiscard]] constexpr return_of<ref<T>> get(const size_t offset) const {
+            return *get_pointer<T, Policy>(offset);
+        }
+
+        /**
+         * @tparam T The type of the value to set.
+         * @param value The value to store at the given offset.
+         * @param offset The offset in bytes from the start of the memory block. The data offset will be checked to ensure it is within bounds.
+         */
+        template<typename T, typename Policy = default_check> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof(T) < sizeof(uintptr_t))
+        constexpr void set(const T value, const size_t offset) {
+            *get_pointer<T, Policy>(offset) = value;
+        }
+
+        /**
+         * @tparam T The type of the value to set.
+         * @param value The value to store at the given offset.
+         * @param offset The offset in bytes from the start of the memory block. The data offset will be checked to ensure it is within bounds.
+         */
+        template<typename T, typename Policy = default_check> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof(T) >= sizeof(uintptr_t))
+        constexpr void set(const T & value, const size_t offset) {
+            *get_pointer<T, Policy>(offset) = value;
+        }
+
+        /**
+         * @tparam T The type of the value to set.
+         * @param value The value to store at the given offset.
+         * @param offset The offset in bytes from the start of the memory block. The data offset will be checked to ensure it is within bounds.
+         */
+        template<typename T, typename Policy = default_check> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof(T) >= sizeof(uintptr_t))
+        constexpr void set(const T * value, const size_t offset) {
+            *get_pointer<T, Policy>(offset) = *value;
+        }
+
+        /**
+         * Reads a batch of values with a single check on the largest offset, see safe::memory::get_many.
+         * @param offsets The offsets in bytes from the start of the memory block.
+         * @param out Receives the value at offsets[i] in out[i].
+         * @throws std::out_of_range if any offset is out of bounds or out is smaller than offsets.
+         */
+        template<typename T, typename Policy = default_check> requires (std::is_fundamental_v<T> || std::is_pod_v<T>)
+        void get_many(const std::span<const size_t> offsets, const std::span<T> out) const {
+            if (!check<std::out_of_range, Policy>(out.size() >= offsets.size() && is_safe_batch<T>(detail::simd::max_of(offsets)), "Offset is out of bounds", check_site::memory_access)) [[unlikely]] {
+                std::memset(out.data(), 0, out.size_bytes());
+                return;
+            }
+            detail::simd::gather(data(), offsets, out.data());
+        }
+
+        /**
+         * Reads a batch of values at offsets which are known at compile time, see safe::memory::get_many.
+         * @return An array with the value at every offset, in the same order as the offsets.
+         */
+        template<typename T, size_t... Offsets> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof...(Offsets) > 0)
+        [[nodiscard]] return_of<std::array<T, sizeof...(Offsets)>> get_many() const {
+            return get_many<T, default_check, Offsets...>();
+        }
+
+        /**
+         * Reads a batch of values at offsets which are known at compile time with an explicit check
+         * policy, e.g. get_many<uint32_t, unsafe_unchecked, 0, 8>().
+         * @return An array with the value at every offset, in the same order as the offsets.
+         */
+        template<typename T, typename Policy, size_t... Offsets> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof...(Offsets) > 0)
+        [[nodiscard]] return_of<std::array<T, sizeof...(Offsets)>> get_many() const {
+            constexpr size_t max_offset = std::max({ Offsets... });
+            std::array<T, sizeof...(Offsets)> result;
+            if (!check<std::out_of_range, Policy>(is_safe_batch<T>(max_offset), "Offset is out of bounds", check_site::memory_access)) [[unlikely]] {
+                std::memset(result.data(), 0, sizeof(result));
+                return result;
+            }
+
+            const std::byte * bytes = data();
+            size_t i = 0;
+            ((std::memcpy(&result[i++], bytes + Offsets, sizeof(T))), ...);
+            return result;
+        }
+
+        /**
+         * Writes a batch of values with a single check on the largest offset, see safe::memory::set_many.
+         * @param offsets The offsets in bytes from the start of the memory block.
+         * @param values The value for offsets[i] is values[i].
+         * @throws std::out_of_range if any offset is out of bounds or values is smaller than offsets.
+         */
+        template<typename T, typename Policy = default_check> requires (std::is_fundamental_v<T> || std::is_pod_v<T>)
+        void set_many(const std::span<const size_t> offsets, const std::span<const T> values) {
+            if (!check<std::out_of_range, Policy>(values.size() >= offsets.size() && is_safe_batch<T>(detail::simd::max_of(offsets)), "Offset is out of bounds", check_site::memory_access)) [[unlikely]] {
+                return;
+            }
+            detail::simd::scatter(data(), offsets, values.data());
+        }
+
+        /**
+         * Gives read-only access to a structure which is described by a safe::layout, see safe::memory::ref_layout.
+         * @param offset The offset in bytes from the start of the memory block where the structure starts.
+         * @throws std::out_of_range if the structure doesn't fit in the memory block.
+         */
+        template<typename Layout, typename Policy = default_check>
+        [[nodiscard]] layout_ref<Layout> ref_layout(const size_t offset = 0) const {
+            if (!check<std::out_of_range, Policy>(is_safe_region(offset, Layout::size()), "Layout is out of bounds", check_site::memory_access)) [[unlikely]] {
+                return layout_ref<Layout>(reinterpret_cast<std::byte *>(detail::check_fallback<std::array<std::byte, Layout::size()>>()));
+            }
+            return layout_ref<Layout>(data() + offset);
+        }
+
+        /**
+         * Gives read and write access to a structure which is described by a safe::layout, see safe::memory::mut_layout.
+         * @param offset The offset in bytes from the start of the memory block where the structure starts.
+         * @throws std::out_of_range if the structure doesn't fit in the memory block.
+         */
+        template<typename Layout, typename Policy = default_check>
+        [[nodiscard]] layout_mut<Layout> mut_layout(const size_t offset = 0) {
+            if (!check<std::out_of_range, Policy>(is_safe_region(offset, Layout::size()), "Layout is out of bounds", check_site::memory_access)) [[unlikely]] {
+                return layout_mut<Layout>(reinterpret_cast<std::byte *>(detail::check_fallback<std::array<std::byte, Layout::size()>>()));
+            }
+            return layout_mut<Layout>(data() + offset);
+        }
+
+        /**
+         * The non-throwing counterpart of get.
+         * @return A value copy of type T at the given offset, or error_code::out_of_bounds.
+         */
+        template<typename T> requires (std::is_fundamental_v<T> || std::is_pod_v<T>)
+        [[nodiscard]] result<T, error_code> try_get(const size_t offset) const noexcept {
+            if (!is_safe_batch<T>(offset)) [[unlikely]] {
+                return failure(error_code::out_of_bounds);
+            }
+            T value;
+            std::memcpy(&value, data() + offset, sizeof(T));
+            return value;
+        }
+
+        /**
+         * The non-throwing counterpart of set.
+         * @return Nothing, or error_code::out_of_bounds in which case nothing was written.
+         */
+        template<typename T> requires (std::is_fundamental_v<T> || std::is_pod_v<T>)
+        [[nodiscard]] result<void, error_code> try_set(const T & value, const size_t offset) noexcept {
+            if (!is_safe_batch<T>(offset)) [[unlikely]] {
+                return failure(error_code::out_of_bounds);
+            }
+            std::memcpy(data() + offset, &value, sizeof(T));
+            return {};
+        }
+
+        /**
+         * The non-throwing counterpart of span.
+         * @return A span of type T starting at the given offset and with the given count, or error_code::out_of_bounds.
+         */
+        template<typename T> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof(T) < sizeof(uintptr_t))
+        [[nodiscard]] result<std::span<T>, error_code> try_span(const size_t offset, const size_t count) const noexcept {
+            if (!detail::span_fits<T>(_size, offset, count)) [[unlikely]] {
+                return failure(error_code::out_of_bounds);
+            }
+            return std::span<T>(reinterpret_cast<T *>(data() + offset), count);
+        }
+
+        /**
+         * Returns a span of type T starting at the given offset and with the given count.
+         * @param offset The offset in bytes from the start of the memory block.
+         * @param count The number of elements in the span. The whole span is checked to be within bounds.
+         * @returns A span of type T starting at the given offset and with the given count.
+         */
+        template<typename T, typename Policy = default_check> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof(T) < sizeof(uintptr_t))
+        [[nodiscard]] constexpr return_of<const std::span<T>> span(const size_t offset, const size_t count) const {
+            if (!check<std::out_of_range, Policy>(detail::span_fits<T>(_size, offset, count), "Offset is out of bounds", check_site::memory_access)) [[unlikely]] {
+                return std::span<T>();
+            }
+            return std::span<T>(reinterpret_cast<T *>(data() + offset), count);
+        }
+    };
+}
+
+#endif //INLINE_MEMORY_HPP
@@ -0,0 +1,187 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Laurens Ruijtenberg
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+#ifndef LAYOUT_HPP
+#define LAYOUT_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+namespace safe {
+
+    /* A string literal which can be used as a template argument, so fields can be looked up by name at compile time */
+    template<size_t N>
+    struct field_name {
+        char value[N] {};
+
+        constexpr field_name(const char (&name)[N]) {
+            for (size_t i = 0; i < N; ++i) {
+                value[i] = name[i];
+            }
+        }
+
+        [[nodiscard]] constexpr std::string_view view() const {
+            return std::string_view(value, N - 1);
+        }
+    };
+
+    /**
+     * Describes one field of a layout.
+     * @tparam Name The name of the field.
+     * @tparam T The type of the field, it must be trivially copyable.
+     */
+    template<field_name Name, typename T>
+    struct field {
+        static_assert(std::is_trivially_copyable_v<T>, "Fields must be trivially copyable.");
+
+        static constexpr auto name = Name;
+        using type = T;
+    };
+
+    /**
+     * A compile-time description of a packed binary structure, for example a fixed format header. The
+     * fields follow each other without padding, in the order in which they are listed. Every offset is
+     * computed at compile time, so once the size of the whole layout has been checked against a memory
+     * block the fields can be read and written without any further bounds checks.
+     *
+     * @note Fields are stored in the byte order of the host.
+     */
+    template<typename... Fields>
+    class layout {
+        static_assert(sizeof...(Fields) > 0, "A layout needs at least one field.");
+
+        static constexpr std::array<std::string_view, sizeof...(Fields)> names = { Fields::name.view()... };
+        static constexpr std::array<size_t, sizeof...(Fields)> sizes = { sizeof(typename Fields::type)... };
+
+        static constexpr bool has_unique_names() {
+            for (size_t i = 0; i < names.size(); ++i) {
+                for (size_t j = i + 1; j < names.size(); ++j) {
+                    if (names[i] == names[j]) return false;
+                }
+            }
+            return true;
+        }
+
+        static_assert(has_unique_names(), "Every field in a layout must have a unique name.");
+
+    public:
+        /**
+         * @return The index of the field with the given name, or the number of fields if there is no such field.
+         */
+        template<field_name Name>
+        [[nodiscard]] static constexpr size_t index_of() {
+            for (size_t i = 0; i < names.size(); ++i) {
+                if (names[i] == Name.view()) return i;
+            }
+            return names.size();
+        }
+
+        template<field_name Name>
+        [[nodiscard]] static constexpr bool has_field() {
+            return index_of<Name>() < sizeof...(Fields);
+        }
+
+        /**
+         * @return The offset in bytes of the field with the given name.
+         */
+        template<field_name Name> requires (has_field<Name>())
+        [[nodiscard]] static constexpr size_t offset_of() {
+            size_t offset = 0;
+            for (size_t i = 0; i < index_of<Name>(); ++i) {
+                offset += sizes[i];
+            }
+            return offset;
+        }
+
+        template<field_name Name> requires (has_field<Name>())
+        using type_of = std::tuple_element_t<index_of<Name>(), std::tuple<typename Fields::type...>>;
+
+        /**
+         * @return The size of the whole layout in bytes.
+         */
+        [[nodiscard]] static constexpr size_t size() {
+            return (sizeof(typename Fields::type) + ...);
+        }
+    };
+
+    /**
+     * Read-only access to a layout in a block of memory. It is handed out by safe::memory after the
+     * size of the whole layout was checked, so reading a field doesn't need a bounds check. Like safe::ref
+     * it is not copyable, so it can't be stored somewhere and outlive the memory.
+     */
+    template<typename Layout>
+    class layout_ref {
+        friend class memory;
+        template<size_t> friend class inline_memory;
+    protected:
+        const std::byte * _data;
+
+        constexpr explicit layout_ref(const std::byte * data) : _data(data) {}
+    public:
+        layout_ref(const layout_ref<Layout> & other) = delete;
+        layout_ref(layout_ref<Layout> && other) noexcept = delete;
+        layout_ref<Layout> & operator=(const layout_ref<Layout> & other) = delete;
+        layout_ref<Layout> & operator=(layout_ref<Layout> && other) noexcept = delete;
+
+        /**
+         * @tparam Name The name of the field to read.
+         * @return A value copy of the field.
+         */
+        template<field_name Name>
+        [[nodiscard]] typename Layout::template type_of<Name> get() const {
+            typename Layout::template type_of<Name> value;
+            std::memcpy(&value, _data + Layout::template offset_of<Name>(), sizeof(value));
+            return value;
+        }
+    };
+
+    /**
+     * Read and write access to a layout in a block of memory, see layout_ref.
+     */
+    template<typename Layout>
+    class layout_mut : public layout_ref<Layout> {
+        friend class memory;
+        template<size_t> friend class inline_memory;
+
+        std::byte * _mutable_data;
+
+        constexpr explicit layout_mut(std::byte * data) : layout_ref<Layout>(data), _mutable_data(data) {}
+    public:
+        /**
+         * @tparam Name The name of the field to write.
+         * @param value The value to store in the field.
+         */
+        template<field_name Name>
+        void set(const typename Layout::template type_of<Name> & value) {
+            std::memcpy(_mutable_data + Layout::template offset_of<Name>(), &value, sizeof(value));
+        }
+    };
+}
+
+#endif //LAYOUT_HPP
@@ -0,0 +1,136 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Laurens Ruijtenberg
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+#ifndef LOCKS_HPP
+#define LOCKS_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #include <immintrin.h>
+#endif
+
+#include "cache_line.hpp"
+
+namespace safe {
+
+    namespace detail {
+        inline void cpu_relax() {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+            _mm_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+            asm volatile("yield");
+#endif
+        }
+    }
+
+    /**
+     * A test-and-test-and-set spinlock for very short critical sections. It satisfies the Lockable
+     * requirements, so it can be used with std::unique_lock and as a lock policy for safe::sync_owner.
+     * After spinning for a while it yields the thread, so it also behaves on oversubscribed machines.
+     */
+    class alignas(cache_line_size) spinlock {
+        std::atomic<bool> _locked = false;
+    public:
+        spinlock() = default;
+        spinlock(const spinlock &other) = delete;
+        spinlock & operator=(const spinlock &other) = delete;
+
+        void lock() {
+            size_t spins = 0;
+            while (_locked.exchange(true, std::memory_order_acquire)) {
+                while (_locked.load(std::memory_order_relaxed)) {
+                    if (++spins < 64) {
+                        detail::cpu_relax();
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+        }
+
+        [[nodiscard]] bool try_lock() {
+            return !_locked.load(std::memory_order_relaxed) && !_locked.exchange(true, std::memory_order_acquire);
+        }
+
+        void unlock() {
+            _locked.store(false, std::memory_order_release);
+        }
+    };
+
+    /**
+     * A sequence lock. Writers are serialized by a spinlock and make the sequence odd while they write.
+     * Readers never write to shared memory: they read the sequence, read the data and retry when the
+     * sequence was odd or has changed in the meantime. Use it through safe::sync_owner<T, safe::seqlock>.
+     */
+    class alignas(cache_line_size) seqlock {
+        std::atomic<size_t> _sequence = 0;
+        spinlock _writer;
+    public:
+        seqlock() = default;
+        seqlock(const seqlock &other) = delete;
+        seqlock & operator=(const seqlock &other) = delete;
+
+        void lock() {
+            _writer.lock();
+            _sequence.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+
+        void unlock() {
+            _sequence.fetch_add(1, std::memory_order_release);
+            _writer.unlock();
+        }
+
+        /**
+         * @return The sequence at which a read starts, it waits until no write is in progress.
+         */
+        [[nodiscard]] size_t read_begin() const {
+            size_t spins = 0;
+            size_t sequence = _sequence.load(std::memory_order_acquire);
+            while (sequence & 1) {
+                if (++spins < 64) {
+                    detail::cpu_relax();
+                } else {
+                    std::this_thread::yield();
+                }
+                sequence = _sequence.load(std::memory_order_acquire);
+            }
+            return sequence;
+        }
+
+        /**
+         * @return True if a write happened since read_begin() returned the given sequence, so the read must be repeated.
+         */
+        [[nodiscard]] bool read_retry(const size_t sequence) const {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return _sequence.load(std::memory_order_relaxed) != sequence;
+        }
+    };
+}
+
+#endif //LOCKS_HPP
@@ -0,0 +1,371 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Laurens Ruijtenberg
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+#ifndef MAPPED_MEMORY_HPP
+#define MAPPED_MEMORY_HPP
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include "check.hpp"
+#include "returnof.hpp"
+
+namespace safe {
+
+    enum class map_access {
+        read_only,
+        read_write
+    };
+
+    /* Hints for the operating system about how the mapped memory is going to be accessed */
+    enum class map_advice {
+        normal,
+        sequential,
+        random,
+        will_need
+    };
+
+    /**
+     * A memory block which is backed by a memory mapped file. It offers the same bounds-checked get/set/span API
+     * as safe::memory, but the pages are only read from disk when they are touched for the first time. So opening a
+     * large file is near instant and doesn't need a heap copy. The file is unmapped when the object goes out of scope.
+     *
+     * Writing to a read-only mapping is treated as an out of bounds access.
+     */
+    class mapped_memory {
+    public:
+        template<typename T>
+        constexpr bool is_safe_index(const size_t offset) const {
+            return (offset + sizeof(T)) < _size;
+        }
+    private:
+        std::byte * _ptr = nullptr;
+        size_t _size = 0;
+        bool _writable = false;
+#if defined(_WIN32)
+        HANDLE _file = INVALID_HANDLE_VALUE;
+        HANDLE _mapping = nullptr;
+#else
+        int _file = -1;
+#endif
+
+        template<typename T>
+        constexpr bool is_safe_batch(const size_t max_offset) const {
+            return detail::fits<T>(_size, max_offset);
+        }
+
+        template<typename T, typename Policy>
+        constexpr T * get_pointer(const size_t offset) const {
+            if (!check<std::out_of_range, Policy>(is_safe_batch<T>(offset), "Offset is out of bounds", check_site::memory_access)) [[unlikely]] {
+                return detail::check_fallback<T>();
+            }
+            return reinterpret_cast<T *>(_ptr + offset);
+        }
+
+        constexpr bool is_safe_region(const size_t offset, const size_t length) const {
+            return detail::region_fits(_size, offset, length);
+        }
+
+        template<typename T, typename Policy>
+        constexpr T * get_writable_pointer(const size_t offset) const {
+            if (!check<std::out_of_range, Policy>(_writable && is_safe_batch<T>(offset), "Offset is out of bounds", check_site::memory_access)) [[unlikely]] {
+                return detail::check_fallback<T>();
+            }
+            return reinterpret_cast<T *>(_ptr + offset);
+        }
+
+        void release() {
+#if defined(_WIN32)
+            if (_ptr != nullptr) UnmapViewOfFile(_ptr);
+            if (_mapping != nullptr) CloseHandle(_mapping);
+            if (_file != INVALID_HANDLE_VALUE) CloseHandle(_file);
+            _mapping = nullptr;
+            _file = INVALID_HANDLE_VALUE;
+#else
+            if (_ptr != nullptr) munmap(_ptr, _size);
+            if (_file != -1) close(_file);
+            _file = -1;
+#endif
+            _ptr = nullptr;
+            _size = 0;
+        }
+
+        /* Reports a failed system call through the check policy and leaves an empty mapping behind */
+        void fail(const char * message) {
+#if defined(_WIN32)
+            const auto error = static_cast<int>(GetLastError());
+#else
+            const auto error = errno;
+#endif
+            release();
+            (void) check_always<std::system_error>(false, message, check_site::other, error, std::system_category());
+        }
+
+    public:
+        /**
+         * Maps the whole file into memory.
+         * @param path The file to map.
+         * @param access Whether the mapping can only be read or also be written. Writes go straight to the file.
+         * @throws std::system_error if the file can't be opened or mapped.
+         */
+        explicit mapped_memory(const std::filesystem::path & path, const map_access access = map_access::read_only)
+            : _writable(access == map_access::read_write) {
+#if defined(_WIN32)
+            _file = CreateFileW(path.c_str(), _writable ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ, FILE_SHARE_READ,
+                nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (_file == INVALID_HANDLE_VALUE) { fail("Unable to open file"); return; }
+
+            LARGE_INTEGER size;
+            if (!GetFileSizeEx(_file, &size)) { fail("Unable to get the file size"); return; }
+            if (size.QuadPart == 0) return;
+
+            _mapping = CreateFileMappingW(_file, nullptr, _writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+            if (_mapping == nullptr) { fail("Unable to map file"); return; }
+
+            _ptr = static_cast<std::byte *>(MapViewOfFile(_mapping, _writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0));
+            if (_ptr == nullptr) { fail("Unable to map file"); return; }
+            _size = static_cast<size_t>(size.QuadPart);
+#else
+            _file = open(path.c_str(), _writable ? O_RDWR : O_RDONLY);
+            if (_file == -1) { fail("Unable to open file"); return; }
+
+            struct stat info {};
+            if (fstat(_file, &info) != 0) { fail("Unable to get the file size"); return; }
+            if (info.st_size == 0) return;
+
+            auto * mapped = mmap(nullptr, static_cast<size_t>(info.st_size), _writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, _file, 0);
+            if (mapped == MAP_FAILED) { fail("Unable to map file"); return; }
+
+            _ptr = static_cast<std::byte *>(mapped);
+            _size = static_cast<size_t>(info.st_size);
+#endif
+        }
+
+        ~mapped_memory() {
+            release();
+        }
+
+        /* A mapping can't be copied, only moved */
+        mapped_memory(const mapped_memory &other) = delete;
+        mapped_memory & operator=(const mapped_memory &other) = delete;
+
+        mapped_memory(mapped_memory &&other) noexcept
+            : _ptr(other._ptr), _size(other._size), _writable(other._writable), _file(other._file) {
+#if defined(_WIN32)
+            _mapping = other._mapping;
+            other._mapping = nullptr;
+            other._file = INVALID_HANDLE_VALUE;
+#else
+            other._file = -1;
+#endif
+            other._ptr = nullptr;
+            other._size = 0;
+        }
+
+        mapped_memory & operator=(mapped_memory &&other) noexcept {
+            if (&other == this) return *this;
+
+            release();
+            std::swap(_ptr, other._ptr);
+            std::swap(_size, other._size);
+            std::swap(_writable, other._writable);
+            std::swap(_file, other._file);
+#if defined(_WIN32)
+            std::swap(_mapping, other._mapping);
+#endif
+            return *this;
+        }
+
+        /**
+         *
+         * @return The size of the mapped file in bytes.
+         */
+        [[nodiscard]] constexpr size_t size() const { return _size; }
+
+        [[nodiscard]] constexpr bool is_writable() const { return _writable; }
+
+        /**
+         * Tells the operating system how a part of the mapping is going to be accessed, so it can read ahead
+         * or drop pages accordingly. The hint is ignored where the platform doesn't support it.
+         * @param advice The expected access pattern.
+         * @param offset The offset in bytes of the region the hint applies to.
+         * @param length The length in bytes of the region the hint applies to.
+         * @throws std::out_of_range if the region is not within the mapping.
+         */
+        void advise(const map_advice advice, const size_t offset, const size_t length) const {
+            if (!check<std::out_of_range>(is_safe_region(offset, length), "Region is out of bounds", check_site::memory_access)) [[unlikely]] {
+                return;
+            }
+            if (length == 0) return;
+
+#if defined(_WIN32)
+            if (advice == map_advice::will_need) {
+                WIN32_MEMORY_RANGE_ENTRY range { _ptr + offset, length };
+                PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+            }
+#else
+            //madvise needs a page aligned start address
+            const auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            const auto start = offset - (offset % page_size);
+
+            int native_advice = MADV_NORMAL;
+            switch (advice) {
+                case map_advice::normal: native_advice = MADV_NORMAL; break;
+                case map_advice::sequential: native_advice = MADV_SEQUENTIAL; break;
+                case map_advice::random: native_advice = MADV_RANDOM; break;
+                case map_advice::will_need: native_advice = MADV_WILLNEED; break;
+            }
+            madvise(_ptr + start, length + (offset - start), native_advice);
+#endif
+        }
+
+        /**
+         * Gives the operating system a hint about how the whole mapping is going to be accessed.
+         */
+        void advise(const map_advice advice) const {
+            advise(advice, 0, _size);
+        }
+
+        /**
+         * Writes all changes back to the file.
+         * @throws std::system_error if the changes couldn't be written.
+         */
+        void flush() const {
+            if (_ptr == nullptr || !_writable) return;
+#if defined(_WIN32)
+            if (!FlushViewOfFile(_ptr, _size) || !FlushFileBuffers(_file)) {
+                (void) check_always<std::system_error>(false, "Unable to flush mapping", check_site::other, static_cast<int>(GetLastError()), std::system_category());
+            }
+#else
+            if (msync(_ptr, _size, MS_SYNC) != 0) {
+                (void) check_always<std::system_error>(false, "Unable to flush mapping", check_site::other, errno, std::system_category());
+            }
+#endif
+        }
+
+        /**
+         * @note T must be a fundamental type or a POD (Plain Old Data) type
+         * @return A value copy of type T at the given offset.
+         */
+        template<typename T, typename Policy = default_check> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof(T) < sizeof(uintptr_t))
+        [[nodiscard]] constexpr return_of<T> get(const size_t offset) const {
+            return *get_pointer<T, Policy>(offset);
+        }
+
+        /**
+         *
+         * @tparam T The type of the value to get.
+         * @param offset The offset in bytes from the start of the mapping. The data offset will be checked to ensure it is within bounds.
+         * @note T must be a fundamental type or a POD (Plain Old Data) type.
+         * @return A pointer to type T at the given offset.
+         */
+        template<typename T, typename Policy = default_check> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof(T) >= sizeof(uintptr_t))
+        [[nodiscard]] constexpr return_of<ref<T>> get(const size_t offset) const {
+            return *get_pointer<T, Policy>(offset);
+        }
+
+        /**
+         *
+         * @tparam T The type of the value to set.
+         * @param value The value to store at the given offset.
+         * @param offset The offset in bytes from the start of the mapping. The data offset will be checked to ensure it is within bounds.
+         */
+        template<typename T, typename Policy = default_check> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof(T) < sizeof(uintptr_t))
+        constexpr void set(const T value, const size_t offset) {
+            *get_writable_pointer<T, Policy>(offset) = value;
+        }
+
+        /**
+         *
+         * @tparam T The type of the value to set.
+         * @param value The value to store at the given offset.
+         * @param offset The offset in bytes from the start of the mapping. The data offset will be checked to ensure it is within bounds.
+         */
+        template<typename T, typename Policy = default_check> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof(T) >= sizeof(uintptr_t))
+        constexpr void set(const T & value, const size_t offset) {
+            *get_writable_pointer<T, Policy>(offset) = value;
+        }
+
+        /**
+         *
+         * @tparam T The type of the value to set.
+         * @param value The value to store at the given offset.
+         * @param offset The offset in bytes from the start of the mapping. The data offset will be checked to ensure it is within bounds.
+         */
+        template<typename T, typename Policy = default_check> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof(T) >= sizeof(uintptr_t))
+        constexpr void set(const T * value, const size_t offset) {
+            *get_writable_pointer<T, Policy>(offset) = *value;
+        }
+
+        /**
+         * Returns a span of type T starting at the given offset and with the given count.
+         * @tparam T The type of the elements in the span.
+         * @param offset The offset in bytes from the start of the mapping. The data offset will be checked to ensure it is within bounds.
+         * @param count The number of elements of type T in the span.
+         * @returns A span of type T starting at the given offset and with the given count. The elements are const for a read-only mapping.
+         */
+        template<typename T, typename Policy = default_check> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof(T) < sizeof(uintptr_t))
+        [[nodiscard]] constexpr return_of<const std::span<const T>> span(const size_t offset, const size_t count) const {
+            //the whole span has to be within bounds
+            if (!check<std::out_of_range, Policy>(detail::span_fits<T>(_size, offset, count), "Offset is out of bounds", check_site::memory_access)) [[unlikely]] {
+                return std::span<const T>();
+            }
+            return std::span<const T>(reinterpret_cast<const T *>(_ptr + offset), count);
+        }
+
+        /**
+         * Returns a writable span of type T starting at the given offset and with the given count.
+         * @throws std::out_of_range if the region is out of bounds or the mapping is read-only.
+         */
+        template<typename T, typename Policy = default_check> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof(T) < sizeof(uintptr_t))
+        [[nodiscard]] constexpr return_of<const std::span<T>> mut_span(const size_t offset, const size_t count) {
+            if (!check<std::out_of_range, Policy>(_writable && detail::span_fits<T>(_size, offset, count), "Offset is out of bounds", check_site::memory_access)) [[unlikely]] {
+                return std::span<T>();
+            }
+            return std::span<T>(reinterpret_cast<T *>(_ptr + offset), count);
+        }
+    };
+}
+
+#endif //MAPPED_MEMORY_HPP
@@ -25,12 +25,23 @@
 #ifndef MEMORY_H
 #define MEMORY_H
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <limits>
 #include <memory>
+#include <optional>
 #include <span>
 #include <stdexcept>
 #include <type_traits>
 
+#include "allocation.hpp"
+#include "check.hpp"
+#include "layout.hpp"
+#include "result.hpp"
 #include "returnof.hpp"
+#include "simd.hpp"
 
 namespace safe {
 
@@ -39,23 +50,70 @@ namespace safe {
      * It allows for reading and writing fundamental types and PODs
      * while ensuring that accesses are within bounds. It's meant
      * as a safer alternative to void pointers.
+     * A failed bounds check is handled by the check policy, which throws
+     * std::out_of_range unless SAFE_CHECK_POLICY selects another mode.
+     * The block can be aligned beyond alignof(std::max_align_t) and backed with huge pages, see memory_options.
      */
     class memory {
+        friend class reader;
+        friend class writer;
     public:
         template<typename T>
         constexpr bool is_safe_index(const size_t offset) const {
             return (offset + sizeof(T)) < _size;
         }
     private:
-        mutable std::unique_ptr<std::byte[]> _ptr = nullptr;
+        mutable detail::block_ptr _ptr = nullptr;
         mutable size_t _size = 0;
 
-        template<typename T>
+        template<typename T, typename Policy>
         constexpr T * get_pointer(const size_t offset) const {
-            /* The goal of this method is to do branchless bounds checks */
-            const uintptr_t mask = ((offset + sizeof(T)) < _size);
-            auto base = reinterpret_cast<uintptr_t>(_ptr.get() + offset);
-            return reinterpret_cast<T *>(base * mask);
+            //the check is a predicted branch with an outlined failure path, so the hot path is a compare and a load. The
+            //base pointer is read before the branch, otherwise the load only happens behind it and can't leave a loop.
+            std::byte * const base = _ptr.get();
+            if (!check<std::out_of_range, Policy>(is_safe_batch<T>(offset), "Offset is out of bounds", check_site::memory_access)) [[unlikely]] {
+                return detail::check_fallback<T>();
+            }
+            return reinterpret_cast<T *>(base + offset);
+        }
+
+        template<typename T>
+        constexpr bool is_safe_batch(const size_t max_offset) const {
+            return detail::fits<T>(_size, max_offset);
+        }
+
+        constexpr bool is_safe_region(const size_t offset, const size_t length) const {
+            return detail::region_fits(_size, offset, length);
+        }
+
+        template<typename T>
+        constexpr bool is_safe_span(const size_t offset, const size_t count) const {
+            return detail::span_fits<T>(_size, offset, count);
+        }
+
+        template<typename T>
+        std::optional<size_t> find_unchecked(const T & value, const size_t offset, const size_t count) const {
+            const auto index = detail::simd::find(_ptr.get() + offset, count, value);
+            if (index == count) {
+                return std::nullopt;
+            }
+            return offset + index * sizeof(T);
+        }
+
+        //memcpy and memmove are already vectorized by the C library, memmove only costs extra when the regions really overlap
+        static void copy_bytes(std::byte * destination, const std::byte * source, const size_t length, const bool may_overlap) {
+            if (length == 0) return;
+            if (may_overlap) {
+                std::memmove(destination, source, length);
+            } else {
+                std::memcpy(destination, source, length);
+            }
+        }
+
+        //the deleter knows the alignment and the requested backing, so a copy doesn't have to keep its own options
+        memory_options copy_options() const {
+            const auto & deleter = _ptr.get_deleter();
+            return memory_options { deleter.alignment, deleter.requested };
         }
 
         constexpr void release() const {
@@ -71,16 +129,28 @@ namespace safe {
          * @param size The size of the memory block to allocate in bytes.
          */
         constexpr memory(const size_t size): _ptr(nullptr), _size(0) {
-            _ptr = std::make_unique<std::byte[]>(size);
+            _ptr = detail::block_ptr(new std::byte[size](), detail::block_deleter {});
             _size = size;
         }
 
+        /**
+         * Initializes a memory block with the given size, alignment and page backing.
+         * @param size The size of the memory block to allocate in bytes.
+         * @param options The alignment of the block and the pages it's backed with.
+         * @throws std::invalid_argument if the alignment is not a power of two. The block is empty when the check
+         * policy doesn't throw.
+         */
+        memory(const size_t size, const memory_options options) {
+            _ptr = detail::allocate_block(size, options);
+            _size = _ptr != nullptr ? size : 0;
+        }
+
         constexpr ~memory() {
             release();
         }
 
         memory(const memory &other) {
-            _ptr = std::make_unique<std::byte[]>(other._size);
+            _ptr = detail::allocate_block(other._size, other.copy_options());
             _size = other._size;
 
             //ps:memcpy causes this to not be constexpr
@@ -92,7 +162,7 @@ namespace safe {
 
             release();
     
-            _ptr = std::make_unique<std::byte[]>(other._size);
+            _ptr = detail::allocate_block(other._size, other.copy_options());
             _size = other._size;
 
             //ps:memcpy causes this to not be constexpr
@@ -123,13 +193,24 @@ namespace safe {
          */
         [[nodiscard]] constexpr size_t size() const { return _size; }
 
+        /**
+         * @return The alignment of the start of the memory block in bytes.
+         */
+        [[nodiscard]] constexpr size_t alignment() const { return _ptr.get_deleter().alignment; }
+
+        /**
+         * @return The pages the memory block is actually backed with. A request for huge pages can fall back to
+         * transparent or regular pages when the operating system has none available.
+         */
+        [[nodiscard]] constexpr page_backing pages() const { return _ptr.get_deleter().pages; }
+
         /**
          * @note T must be a fundamental type or a POD (Plain Old Data) type
          * @return A value copy of type T at the given offset.
          */
-        template<typename T> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof(T) < sizeof(uintptr_t))
+        template<typename T, typename Policy = default_check> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof(T) < sizeof(uintptr_t))
         [[nodiscard]] constexpr return_of<T> get(const size_t offset) const {
-            return *get_pointer<T>(offset);
+            return *get_pointer<T, Policy>(offset);
         }
         
         /**
@@ -139,9 +220,9 @@ namespace safe {
          * @note T must be a fundamental type or a POD (Plain Old Data) type.
          * @return A pointer to type T at the given offset.
          */
-        template<typename T> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof(T) >= sizeof(uintptr_t))
+        template<typename T, typename Policy = default_check> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof(T) >= sizeof(uintptr_t))
         [[nodiscard]] constexpr return_of<ref<T>> get(const size_t offset) const {
-            return *get_pointer<T>(offset);
+            return *get_pointer<T, Policy>(offset);
         }
 
         /**
@@ -150,9 +231,9 @@ namespace safe {
          * @param value The value to store at the given offset.
          * @param offset The offset in bytes from the start of the memory block. The data offset will be checked to ensure it is within bounds.
          */
-        template<typename T> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof(T) < sizeof(uintptr_t))
+        template<typename T, typename Policy = default_check> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof(T) < sizeof(uintptr_t))
         constexpr void set(const T value, const size_t offset) {
-            *get_pointer<T>(offset) = value;
+            *get_pointer<T, Policy>(offset) = value;
         }
 
         /**
@@ -161,9 +242,9 @@ namespace safe {
          * @param value The value to store at the given offset.
          * @param offset The offset in bytes from the start of the memory block. The data offset will be checked to ensure it is within bounds.
          */
-        template<typename T> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof(T) >= sizeof(uintptr_t))
+        template<typename T, typename Policy = default_check> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof(T) >= sizeof(uintptr_t))
         constexpr void set(const T & value, const size_t offset) {
-            *get_pointer<T>(offset) = value;
+            *get_pointer<T, Policy>(offset) = value;
         }
 
         /**
@@ -172,27 +253,376 @@ namespace safe {
          * @param value The value to store at the given offset.
          * @param offset The offset in bytes from the start of the memory block. The data offset will be checked to ensure it is within bounds.
          */
-        template<typename T> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof(T) >= sizeof(uintptr_t))
+        template<typename T, typename Policy = default_check> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof(T) >= sizeof(uintptr_t))
         constexpr void set(const T * value, const size_t offset) {
-            *get_pointer<T>(offset) = *value;
+            *get_pointer<T, Policy>(offset) = *value;
         }
 
         /**
-         * Returns a span of type T starting at the given offset and with the given count. This is useful for accessing a range of memory as an array
-         * in a type-safe and performant way.
+         * Reads a batch of values in one go. The whole batch is validated with a single check
+         * on the largest offset, after which the values are loaded without per-element checks
+         * (using SIMD gathers when the CPU supports them).
+         * @tparam T The type of the values to get.
+         * @param offsets The offsets in bytes from the start of the memory block.
+         * @param out Receives the value at offsets[i] in out[i].
+         * @throws std::out_of_range if any offset is out of bounds or out is smaller than offsets.
+         */
+        template<typename T, typename Policy = default_check> requires (std::is_fundamental_v<T> || std::is_pod_v<T>)
+        void get_many(const std::span<const size_t> offsets, const std::span<T> out) const {
+            if (!check<std::out_of_range, Policy>(out.size() >= offsets.size() && is_safe_batch<T>(detail::simd::max_of(offsets)), "Offset is out of bounds", check_site::memory_access)) [[unlikely]] {
+                std::memset(out.data(), 0, out.size_bytes());
+                return;
+            }
+            detail::simd::gather(_ptr.get(), offsets, out.data());
+        }
+
+        /**
+         * Reads a batch of values at offsets which are known at compile time. The bounds check is
+         * done once on the largest offset.
+         * @tparam T The type of the values to get.
+         * @tparam Offsets The offsets in bytes from the start of the memory block.
+         * @return An array with the value at every offset, in the same order as the offsets.
+         */
+        template<typename T, size_t... Offsets> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof...(Offsets) > 0)
+        [[nodiscard]] return_of<std::array<T, sizeof...(Offsets)>> get_many() const {
+            return get_many<T, default_check, Offsets...>();
+        }
+
+        /**
+         * Reads a batch of values at offsets which are known at compile time with an explicit check
+         * policy, e.g. get_many<uint32_t, unsafe_unchecked, 0, 8>().
+         * @return An array with the value at every offset, in the same order as the offsets.
+         */
+        template<typename T, typename Policy, size_t... Offsets> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof...(Offsets) > 0)
+        [[nodiscard]] return_of<std::array<T, sizeof...(Offsets)>> get_many() const {
+            constexpr size_t max_offset = std::max({ Offsets... });
+            std::array<T, sizeof...(Offsets)> result;
+            if (!check<std::out_of_range, Policy>(is_safe_batch<T>(max_offset), "Offset is out of bounds", check_site::memory_access)) [[unlikely]] {
+                std::memset(result.data(), 0, sizeof(result));
+                return result;
+            }
+
+            size_t i = 0;
+            ((std::memcpy(&result[i++], _ptr.get() + Offsets, sizeof(T))), ...);
+            return result;
+        }
+
+        /**
+         * Gives read-only access to a structure which is described by a safe::layout. The size of
+         * the whole layout is checked once, reading the individual fields is then unchecked.
+         * @tparam Layout The safe::layout which describes the structure.
+         * @param offset The offset in bytes from the start of the memory block where the structure starts.
+         * @throws std::out_of_range if the structure doesn't fit in the memory block.
+         */
+        template<typename Layout, typename Policy = default_check>
+        [[nodiscard]] layout_ref<Layout> ref_layout(const size_t offset = 0) const {
+            if (!check<std::out_of_range, Policy>(is_safe_region(offset, Layout::size()), "Layout is out of bounds", check_site::memory_access)) [[unlikely]] {
+                return layout_ref<Layout>(reinterpret_cast<std::byte *>(detail::check_fallback<std::array<std::byte, Layout::size()>>()));
+            }
+            return layout_ref<Layout>(_ptr.get() + offset);
+        }
+
+        /**
+         * Gives read and write access to a structure which is described by a safe::layout. The size of
+         * the whole layout is checked once, reading and writing the individual fields is then unchecked.
+         * @tparam Layout The safe::layout which describes the structure.
+         * @param offset The offset in bytes from the start of the memory block where the structure starts.
+         * @throws std::out_of_range if the structure doesn't fit in the memory block.
+         */
+        template<typename Layout, typename Policy = default_check>
+        [[nodiscard]] layout_mut<Layout> mut_layout(const size_t offset = 0) {
+            if (!check<std::out_of_range, Policy>(is_safe_region(offset, Layout::size()), "Layout is out of bounds", check_site::memory_access)) [[unlikely]] {
+                return layout_mut<Layout>(reinterpret_cast<std::byte *>(detail::check_fallback<std::array<std::byte, Layout::size()>>()));
+            }
+            return layout_mut<Layout>(_ptr.get() + offset);
+        }
+
+        /**
+         * Writes a batch of values in one go. The whole batch is validated with a single check
+         * on the largest offset before anything is written.
+         * @tparam T The type of the values to set.
+         * @param offsets The offsets in bytes from the start of the memory block.
+         * @param values The value for offsets[i] is values[i].
+         * @throws std::out_of_range if any offset is out of bounds or values is smaller than offsets.
+         */
+        template<typename T, typename Policy = default_check> requires (std::is_fundamental_v<T> || std::is_pod_v<T>)
+        void set_many(const std::span<const size_t> offsets, const std::span<const T> values) {
+            if (!check<std::out_of_range, Policy>(values.size() >= offsets.size() && is_safe_batch<T>(detail::simd::max_of(offsets)), "Offset is out of bounds", check_site::memory_access)) [[unlikely]] {
+                return;
+            }
+            detail::simd::scatter(_ptr.get(), offsets, values.data());
+        }
+
+        /**
+         * The non-throwing counterpart of get.
+         * @tparam T The type of the value to get.
+         * @param offset The offset in bytes from the start of the memory block.
+         * @return A value copy of type T at the given offset, or error_code::out_of_bounds.
+         */
+        template<typename T> requires (std::is_fundamental_v<T> || std::is_pod_v<T>)
+        [[nodiscard]] result<T, error_code> try_get(const size_t offset) const noexcept {
+            if (!is_safe_batch<T>(offset)) [[unlikely]] {
+                return failure(error_code::out_of_bounds);
+            }
+            T value;
+            std::memcpy(&value, _ptr.get() + offset, sizeof(T));
+            return value;
+        }
+
+        /**
+         * The non-throwing counterpart of set.
          * @tparam T The type of the value to set.
          * @param value The value to store at the given offset.
-         * @param offset The offset in bytes from the start of the memory block. The data offset will be checked to ensure it is within bounds.
-         * @returns A span of type T starting at the given offset and with the given count.
+         * @param offset The offset in bytes from the start of the memory block.
+         * @return Nothing, or error_code::out_of_bounds in which case nothing was written.
+         */
+        template<typename T> requires (std::is_fundamental_v<T> || std::is_pod_v<T>)
+        [[nodiscard]] result<void, error_code> try_set(const T & value, const size_t offset) noexcept {
+            if (!is_safe_batch<T>(offset)) [[unlikely]] {
+                return failure(error_code::out_of_bounds);
+            }
+            std::memcpy(_ptr.get() + offset, &value, sizeof(T));
+            return {};
+        }
+
+        /**
+         * The non-throwing counterpart of span.
+         * @return A span of type T starting at the given offset and with the given count, or error_code::out_of_bounds.
          */
         template<typename T> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof(T) < sizeof(uintptr_t))
+        [[nodiscard]] result<std::span<T>, error_code> try_span(const size_t offset, const size_t count) const noexcept {
+            if (!is_safe_span<T>(offset, count)) [[unlikely]] {
+                return failure(error_code::out_of_bounds);
+            }
+            return std::span<T>(reinterpret_cast<T *>(_ptr.get() + offset), count);
+        }
+
+        /**
+         * Returns a span of type T starting at the given offset and with the given count. This is useful for accessing a range of memory as an array
+         * in a type-safe and performant way.
+         * @tparam T The type of the elements in the span.
+         * @param offset The offset in bytes from the start of the memory block.
+         * @param count The number of elements in the span. The whole span is checked to be within bounds.
+         * @returns A span of type T starting at the given offset and with the given count.
+         */
+        template<typename T, typename Policy = default_check> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof(T) < sizeof(uintptr_t))
         [[nodiscard]] constexpr return_of<const std::span<T>> span(const size_t offset, const size_t count) const {
-            //we need to ensure that the latest element (offset + count) is within bounds
-            if (!is_safe_index<T>(offset + count)) {
-                throw std::out_of_range("Offset is out of bounds");
+            if (!check<std::out_of_range, Policy>(is_safe_span<T>(offset, count), "Offset is out of bounds", check_site::memory_access)) [[unlikely]] {
+                return std::span<T>();
             }
             return std::span<T>(reinterpret_cast<T *>(_ptr.get() + offset), count);
         }
+
+        /**
+         * Returns a span like span(), but also checks that it starts on an Alignment byte boundary. The start is passed
+         * through std::assume_aligned, so when the access is inlined the compiler can use aligned vector loads and stores.
+         * @tparam Alignment The alignment of the first element in bytes, e.g. 64 for AVX-512.
+         * @param offset The offset in bytes from the start of the memory block.
+         * @param count The number of elements in the span. The whole span is checked to be within bounds.
+         * @throws std::out_of_range if the span is not within the memory block.
+         * @throws std::invalid_argument if the start of the span is not aligned to Alignment.
+         */
+        template<typename T, size_t Alignment, typename Policy = default_check> requires ((std::is_fundamental_v<T> || std::is_pod_v<T>) && sizeof(T) < sizeof(uintptr_t) && std::has_single_bit(Alignment) && Alignment >= alignof(T))
+        [[nodiscard]] return_of<const std::span<T>> aligned_span(const size_t offset, const size_t count) const {
+            if (!check<std::out_of_range, Policy>(is_safe_span<T>(offset, count), "Offset is out of bounds", check_site::memory_access)) [[unlikely]] {
+                return std::span<T>();
+            }
+            auto * start = _ptr.get() + offset;
+            if (!check<std::invalid_argument, Policy>(reinterpret_cast<uintptr_t>(start) % Alignment == 0, "Span is not aligned", check_site::memory_access)) [[unlikely]] {
+                return std::span<T>();
+            }
+            return std::span<T>(std::assume_aligned<Alignment>(reinterpret_cast<T *>(start)), count);
+        }
+
+        /**
+         * Copies bytes from another memory block into this one. Both regions are checked once, after which the bytes are
+         * copied with memcpy. The source may be this block itself, then the regions are allowed to overlap (memmove).
+         * @param source The memory block to copy from.
+         * @param source_offset The offset in bytes in the source where the copy starts.
+         * @param offset The offset in bytes in this block where the bytes are written.
+         * @param length The number of bytes to copy.
+         * @throws std::out_of_range if either region is out of bounds, in which case nothing is copied.
+         */
+        template<typename Policy = default_check>
+        void copy_from(const memory & source, const size_t source_offset, const size_t offset, const size_t length) {
+            if (!check<std::out_of_range, Policy>(source.is_safe_region(source_offset, length) && is_safe_region(offset, length), "Copy is out of bounds", check_site::memory_access)) [[unlikely]] {
+                return;
+            }
+            copy_bytes(_ptr.get() + offset, source._ptr.get() + source_offset, length, &source == this);
+        }
+
+        /**
+         * Copies bytes from a span into this block. The span may point into this block, so the regions are allowed to overlap.
+         * @param source The bytes to copy.
+         * @param offset The offset in bytes in this block where the bytes are written.
+         * @throws std::out_of_range if the bytes don't fit in this block, in which case nothing is copied.
+         */
+        template<typename Policy = default_check>
+        void copy_from(const std::span<const std::byte> source, const size_t offset) {
+            if (!check<std::out_of_range, Policy>(is_safe_region(offset, source.size()), "Copy is out of bounds", check_site::memory_access)) [[unlikely]] {
+                return;
+            }
+            copy_bytes(_ptr.get() + offset, source.data(), source.size(), true);
+        }
+
+        /**
+         * Copies bytes from this block into another memory block, see copy_from.
+         * @param destination The memory block to copy to. It may be this block itself, then the regions are allowed to overlap.
+         * @param destination_offset The offset in bytes in the destination where the bytes are written.
+         * @param offset The offset in bytes in this block where the copy starts.
+         * @param length The number of bytes to copy.
+         * @throws std::out_of_range if either region is out of bounds, in which case nothing is copied.
+         */
+        template<typename Policy = default_check>
+        void copy_to(memory & destination, const size_t destination_offset, const size_t offset, const size_t length) const {
+            destination.copy_from<Policy>(*this, offset, destination_offset, length);
+        }
+
+        /**
+         * Copies bytes from this block into a span. The span may point into this block, so the regions are allowed to overlap.
+         * @param destination Receives the bytes, its size is the number of bytes to copy.
+         * @param offset The offset in bytes in this block where the copy starts.
+         * @throws std::out_of_range if the region is out of bounds, in which case nothing is copied.
+         */
+        template<typename Policy = default_check>
+        void copy_to(const std::span<std::byte> destination, const size_t offset) const {
+            if (!check<std::out_of_range, Policy>(is_safe_region(offset, destination.size()), "Copy is out of bounds", check_site::memory_access)) [[unlikely]] {
+                return;
+            }
+            copy_bytes(destination.data(), _ptr.get() + offset, destination.size(), true);
+        }
+
+        /**
+         * Writes the same value count times, one after the other. The whole region is checked once and then filled with
+         * vector stores, which is a lot faster than calling set<T> for every element.
+         * @param value The value to repeat.
+         * @param offset The offset in bytes from the start of the memory block where the first value is written.
+         * @param count The number of values to write.
+         * @throws std::out_of_range if the region is out of bounds, in which case nothing is written.
+         */
+        template<typename T, typename Policy = default_check> requires (std::is_fundamental_v<T> || std::is_pod_v<T>)
+        void fill(const T & value, const size_t offset, const size_t count) {
+            if (!check<std::out_of_range, Policy>(detail::span_fits<T>(_size, offset, count), "Fill is out of bounds", check_site::memory_access)) [[unlikely]] {
+                return;
+            }
+            detail::simd::fill(_ptr.get() + offset, count, value);
+        }
+
+        /**
+         * Compares a region of this block with a region of another block byte by byte, like std::memcmp.
+         * @param other The memory block to compare with, which may be this block itself.
+         * @param other_offset The offset in bytes in the other block where the comparison starts.
+         * @param offset The offset in bytes in this block where the comparison starts.
+         * @param length The number of bytes to compare.
+         * @return A negative value if this region orders before the other one, zero if they are equal and a positive value otherwise.
+         * When the check policy doesn't throw, a region out of bounds compares as std::numeric_limits<int>::min(), so it never
+         * counts as equal.
+         * @throws std::out_of_range if either region is out of bounds.
+         */
+        template<typename Policy = default_check>
+        [[nodiscard]] int compare(const memory & other, const size_t other_offset, const size_t offset, const size_t length) const {
+            if (!check<std::out_of_range, Policy>(other.is_safe_region(other_offset, length) && is_safe_region(offset, length), "Compare is out of bounds", check_site::memory_access)) [[unlikely]] {
+                return std::numeric_limits<int>::min();
+            }
+            return length == 0 ? 0 : std::memcmp(_ptr.get() + offset, other._ptr.get() + other_offset, length);
+        }
+
+        /**
+         * The non-throwing counterpart of compare.
+         * @return The result of compare, or error_code::out_of_bounds if either region is out of bounds.
+         */
+        [[nodiscard]] result<int, error_code> try_compare(const memory & other, const size_t other_offset, const size_t offset, const size_t length) const noexcept {
+            if (!other.is_safe_region(other_offset, length) || !is_safe_region(offset, length)) [[unlikely]] {
+                return failure(error_code::out_of_bounds);
+            }
+            return length == 0 ? 0 : std::memcmp(_ptr.get() + offset, other._ptr.get() + other_offset, length);
+        }
+
+        /**
+         * Searches for the first occurrence of a byte.
+         * @param value The byte to search for.
+         * @param offset The offset in bytes where the search starts.
+         * @param length The number of bytes to search.
+         * @return The offset of the byte from the start of the memory block, or std::nullopt if it doesn't occur in the region.
+         * @throws std::out_of_range if the region is out of bounds. Use try_find_byte to tell the two apart without exceptions.
+         */
+        template<typename Policy = default_check>
+        [[nodiscard]] std::optional<size_t> find_byte(const std::byte value, const size_t offset, const size_t length) const {
+            return find<std::byte, Policy>(value, offset, length);
+        }
+
+        /**
+         * Searches for the first value which is bitwise equal to the given one. The values are count elements of T that follow
+         * each other from offset onwards, so only offsets at a multiple of sizeof(T) from offset are compared.
+         * @param value The value to search for.
+         * @param offset The offset in bytes of the first element.
+         * @param count The number of elements to search.
+         * @return The offset of the value from the start of the memory block, or std::nullopt if it doesn't occur in the region.
+         * @throws std::out_of_range if the region is out of bounds. A policy which doesn't throw also gets std::nullopt then,
+         * use try_find to tell a region out of bounds apart from a value which doesn't occur.
+         */
+        template<typename T, typename Policy = default_check> requires (std::is_fundamental_v<T> || std::is_pod_v<T>)
+        [[nodiscard]] std::optional<size_t> find(const T & value, const size_t offset, const size_t count) const {
+            if (!check<std::out_of_range, Policy>(is_safe_span<T>(offset, count), "Find is out of bounds", check_site::memory_access)) [[unlikely]] {
+                return std::nullopt;
+            }
+            return find_unchecked(value, offset, count);
+        }
+
+        /**
+         * The non-throwing counterpart of find.
+         * @return The offset of the value, std::nullopt if it doesn't occur in the region or error_code::out_of_bounds if the
+         * region is out of bounds.
+         */
+        template<typename T> requires (std::is_fundamental_v<T> || std::is_pod_v<T>)
+        [[nodiscard]] result<std::optional<size_t>, error_code> try_find(const T & value, const size_t offset, const size_t count) const noexcept {
+            if (!is_safe_span<T>(offset, count)) [[unlikely]] {
+                return failure(error_code::out_of_bounds);
+            }
+            return find_unchecked(value, offset, count);
+        }
+
+        /**
+         * The non-throwing counterpart of find_byte.
+         * @return The offset of the byte, std::nullopt if it doesn't occur in the region or error_code::out_of_bounds if the
+         * region is out of bounds.
+         */
+        [[nodiscard]] result<std::optional<size_t>, error_code> try_find_byte(const std::byte value, const size_t offset, const size_t length) const noexcept {
+            if (!is_safe_region(offset, length)) [[unlikely]] {
+                return failure(error_code::out_of_bounds);
+            }
+            return find_unchecked(value, offset, length);
+        }
+
+        /**
+         * @param offset The offset in bytes where the checksum starts.
+         * @param length The number of bytes to include.
+         * @param crc The checksum of the preceding bytes, to compute a checksum in parts. 0 for the first part.
+         * @return The CRC32C (Castagnoli) checksum of the region, computed with the CRC instructions of the CPU when available.
+         * @throws std::out_of_range if the region is out of bounds.
+         */
+        template<typename Policy = default_check>
+        [[nodiscard]] uint32_t crc32c(const size_t offset, const size_t length, const uint32_t crc = 0) const {
+            if (!check<std::out_of_range, Policy>(is_safe_region(offset, length), "Checksum is out of bounds", check_site::memory_access)) [[unlikely]] {
+                return 0;
+            }
+            return detail::simd::crc32c(crc, _ptr.get() + offset, length);
+        }
+
+        /**
+         * @param offset The offset in bytes where the hash starts.
+         * @param length The number of bytes to include.
+         * @param seed The seed of the hash.
+         * @return The XXH64 hash of the region.
+         * @throws std::out_of_range if the region is out of bounds.
+         */
+        template<typename Policy = default_check>
+        [[nodiscard]] uint64_t xxhash64(const size_t offset, const size_t length, const uint64_t seed = 0) const {
+            if (!check<std::out_of_range, Policy>(is_safe_region(offset, length), "Hash is out of bounds", check_site::memory_access)) [[unlikely]] {
+                return 0;
+            }
+            return detail::simd::xxhash64(_ptr.get() + offset, length, seed);
+        }
     };
 }
 
@@ -26,6 +26,9 @@
 #ifndef OWNER_HPP
 #define OWNER_HPP
 
+#include <type_traits>
+#include <utility>
+
 #include "mut.hpp"
 #include "ref.hpp"
 
@@ -37,9 +40,23 @@ namespace safe {
     class owner
         : public common_operators<T>, common_operators_unmutable<T>
     {
+        //the operator bases read _data through 'deduce this', so they need access to it
+        friend class common_operators<T>;
+        friend class common_operators_unmutable<T>;
     protected:
         T _data;
     public:
+        using common_operators_unmutable<T>::operator+;
+        using common_operators_unmutable<T>::operator-;
+        using common_operators_unmutable<T>::operator*;
+        using common_operators_unmutable<T>::operator/;
+
+        //a raw value on the left hand side, so expressions like 'a * b + a' work on owners
+        friend constexpr T operator+(const T & lhs, const owner & rhs) { return lhs + rhs._data; }
+        friend constexpr T operator-(const T & lhs, const owner & rhs) { return lhs - rhs._data; }
+        friend constexpr T operator*(const T & lhs, const owner & rhs) { return lhs * rhs._data; }
+        friend constexpr T operator/(const T & lhs, const owner & rhs) { return lhs / rhs._data; }
+
         constexpr owner() : _data(T{}) {}
 
         // Add this constructor
@@ -52,11 +69,18 @@ namespace safe {
         
         constexpr owner(const T & data) : _data(data) {}
 
+        constexpr owner(T && data) noexcept(std::is_nothrow_move_constructible_v<T>) : _data(std::move(data)) {}
+
         constexpr owner<T> & operator=(const T & data) {
             _data = data; // Direct assignment
             return *this;
         }
 
+        constexpr owner<T> & operator=(T && data) noexcept(std::is_nothrow_move_assignable_v<T>) {
+            _data = std::move(data); // Move assignment
+            return *this;
+        }
+
         constexpr owner(const owner<T> & other) : _data(other._data) {}
 
         constexpr owner(owner<T> && other) noexcept : _data(std::move(other._data)) {}
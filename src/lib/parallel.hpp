@@ -0,0 +1,341 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Laurens Ruijtenberg
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "cache_line.hpp"
+#include "check.hpp"
+#include "mut.hpp"
+#include "ref.hpp"
+
+namespace safe {
+
+    struct parallel_options {
+        /* The number of elements a worker processes in one go, 0 picks about 8 chunks per worker */
+        size_t grain_size = 0;
+        /* The number of workers including the calling thread, 0 uses every hardware thread */
+        size_t workers = 0;
+    };
+
+    namespace detail {
+        /*
+         * A process wide set of worker threads for the parallel algorithms. One algorithm runs at a time, the calling
+         * thread takes part as worker 0. A parallel algorithm which is started from inside a worker runs inline.
+         */
+        class parallel_pool {
+            std::mutex _job_mutex;
+            std::mutex _mutex;
+            std::condition_variable _wake;
+            std::condition_variable _done;
+            const std::function<void(size_t)> * _job = nullptr;
+            size_t _generation = 0;
+            size_t _participants = 0;
+            size_t _running = 0;
+            bool _stop = false;
+            std::vector<std::jthread> _threads;
+
+            static bool & inside_worker() {
+                thread_local bool inside = false;
+                return inside;
+            }
+
+            void work(const size_t index) {
+                inside_worker() = true;
+                size_t seen = 0;
+                for (;;) {
+                    std::unique_lock lock(_mutex);
+                    _wake.wait(lock, [&] { return _stop || _generation != seen; });
+                    if (_stop) return;
+                    seen = _generation;
+                    if (index >= _participants) continue;
+
+                    const auto * job = _job;
+                    lock.unlock();
+                    (*job)(index);
+                    lock.lock();
+                    if (--_running == 0) {
+                        _done.notify_one();
+                    }
+                }
+            }
+
+        public:
+            explicit parallel_pool(const size_t size) {
+                for (size_t i = 1; i < size; ++i) {
+                    _threads.emplace_back([this, i] { work(i); });
+                }
+            }
+
+            ~parallel_pool() {
+                {
+                    std::lock_guard lock(_mutex);
+                    _stop = true;
+                }
+                _wake.notify_all();
+            }
+
+            parallel_pool(const parallel_pool &) = delete;
+            parallel_pool & operator=(const parallel_pool &) = delete;
+
+            static parallel_pool & instance() {
+                static parallel_pool pool(std::max<size_t>(1, std::thread::hardware_concurrency()));
+                return pool;
+            }
+
+            [[nodiscard]] size_t size() const {
+                return _threads.size() + 1;
+            }
+
+            /* Runs job(worker) on the given number of workers and returns when all of them are done */
+            void run(size_t workers, const std::function<void(size_t)> & job) {
+                workers = std::min(workers, size());
+                if (workers <= 1 || inside_worker()) {
+                    job(0);
+                    return;
+                }
+
+                std::lock_guard job_lock(_job_mutex);
+                {
+                    std::lock_guard lock(_mutex);
+                    _job = &job;
+                    _participants = workers;
+                    _running = workers - 1;
+                    ++_generation;
+                }
+                _wake.notify_all();
+
+                inside_worker() = true;
+                job(0);
+                inside_worker() = false;
+
+                std::unique_lock lock(_mutex);
+                _done.wait(lock, [&] { return _running == 0; });
+                _job = nullptr;
+            }
+        };
+
+        /*
+         * Hands out chunk indices. Every worker first takes the chunks of its own contiguous region, so it keeps
+         * working on memory it touched before, and then steals the remaining chunks of the other regions.
+         */
+        class chunk_scheduler {
+            struct alignas(cache_line_size) region {
+                std::atomic<size_t> next = 0;
+                size_t end = 0;
+            };
+
+            std::unique_ptr<region[]> _regions;
+            size_t _workers;
+
+        public:
+            chunk_scheduler(const size_t chunk_count, const size_t workers)
+                : _regions(std::make_unique<region[]>(workers)), _workers(workers) {
+                for (size_t w = 0; w < workers; ++w) {
+                    _regions[w].next.store(chunk_count * w / workers, std::memory_order_relaxed);
+                    _regions[w].end = chunk_count * (w + 1) / workers;
+                }
+            }
+
+            template<typename Fn>
+            void run(const size_t worker, Fn && fn) {
+                for (size_t k = 0; k < _workers; ++k) {
+                    region & current = _regions[(worker + k) % _workers];
+                    for (;;) {
+                        const size_t chunk = current.next.fetch_add(1, std::memory_order_relaxed);
+                        if (chunk >= current.end) break;
+                        fn(chunk);
+                    }
+                }
+            }
+        };
+
+        inline size_t parallel_workers(const size_t count, const parallel_options options) {
+            return std::max<size_t>(1, std::min(options.workers == 0 ? parallel_pool::instance().size() : options.workers, count));
+        }
+
+        inline size_t parallel_grain(const size_t count, const parallel_options options) {
+            return options.grain_size != 0 ? options.grain_size : std::max<size_t>(1, count / (parallel_workers(count, options) * 8));
+        }
+
+        /* Splits [0, count) into chunks and calls fn(begin, end, chunk) for every chunk on the parallel pool */
+        template<typename Fn>
+        void parallel_chunks(const size_t count, const parallel_options options, Fn && fn) {
+            if (count == 0) return;
+
+            parallel_pool & pool = parallel_pool::instance();
+            const size_t workers = parallel_workers(count, options);
+            const size_t grain = parallel_grain(count, options);
+            const size_t chunk_count = (count + grain - 1) / grain;
+
+            chunk_scheduler scheduler(chunk_count, std::min(workers, chunk_count));
+            std::mutex error_mutex;
+            std::exception_ptr error;
+            std::atomic<bool> failed = false;
+
+            pool.run(std::min(workers, chunk_count), [&](const size_t worker) {
+                scheduler.run(worker, [&](const size_t chunk) {
+                    if (failed.load(std::memory_order_relaxed)) return;
+#if defined(__cpp_exceptions) || defined(_CPPUNWIND)
+                    try {
+                        fn(chunk * grain, std::min(count, (chunk + 1) * grain), chunk);
+                    } catch (...) {
+                        std::lock_guard lock(error_mutex);
+                        if (!error) error = std::current_exception();
+                        failed.store(true, std::memory_order_relaxed);
+                    }
+#else
+                    fn(chunk * grain, std::min(count, (chunk + 1) * grain), chunk);
+#endif
+                });
+            });
+
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+
+    /**
+     * Calls fn for every element on the parallel pool. Every element is handed out exactly once as a safe::mut,
+     * so two workers can never write to the same element.
+     * @param range A contiguous range, like a std::vector, std::array or a span from safe::memory.
+     * @param fn Called as fn(safe::mut<T>) for every element.
+     * @param options The grain size and the number of workers.
+     * @throws The first exception thrown by fn, after all workers stopped.
+     */
+    template<std::ranges::contiguous_range Range, typename Fn>
+        requires (std::ranges::sized_range<Range> && !std::is_const_v<std::remove_reference_t<std::ranges::range_reference_t<Range>>>)
+    void parallel_for_each(Range && range, Fn fn, const parallel_options options = {}) {
+        using T = std::remove_reference_t<std::ranges::range_reference_t<Range>>;
+        const std::span<T> values(std::ranges::data(range), std::ranges::size(range));
+
+        detail::parallel_chunks(values.size(), options, [&](const size_t begin, const size_t end, size_t) {
+            for (size_t i = begin; i < end; ++i) {
+                fn(mut<T>::create_from(values[i]));
+            }
+        });
+    }
+
+    /**
+     * Calls fn once per chunk on the parallel pool. The chunks are disjoint and every element is in exactly one of
+     * them, so a worker can write its whole chunk without aliasing another one. Use it instead of parallel_for_each
+     * when fn wants a whole run of elements at once, e.g. to vectorize it.
+     * @param range A contiguous range, like a std::vector, std::array or a span from safe::memory.
+     * @param fn Called as fn(safe::mut<std::span<T>>) for every chunk, a chunk has at most grain size elements.
+     * @param options The grain size and the number of workers.
+     * @throws The first exception thrown by fn, after all workers stopped.
+     */
+    template<std::ranges::contiguous_range Range, typename Fn>
+        requires (std::ranges::sized_range<Range> && !std::is_const_v<std::remove_reference_t<std::ranges::range_reference_t<Range>>>)
+    void parallel_for_each_chunk(Range && range, Fn fn, const parallel_options options = {}) {
+        using T = std::remove_reference_t<std::ranges::range_reference_t<Range>>;
+        const std::span<T> values(std::ranges::data(range), std::ranges::size(range));
+
+        detail::parallel_chunks(values.size(), options, [&](const size_t begin, const size_t end, size_t) {
+            std::span<T> chunk = values.subspan(begin, end - begin);
+            fn(mut<std::span<T>>::create_from(chunk));
+        });
+    }
+
+    /**
+     * Writes fn(input[i]) to output[i] on the parallel pool. The inputs are passed as a read-only safe::ref.
+     * @param input A contiguous range with the input values.
+     * @param output A contiguous range which receives the results, it must be at least as large as the input.
+     * @param fn Called as fn(const safe::ref<In> &) for every input element.
+     * @param options The grain size and the number of workers.
+     * @throws std::out_of_range if output is smaller than input, or the first exception thrown by fn. Nothing is
+     * written when the check policy doesn't throw.
+     */
+    template<typename Policy = default_check, std::ranges::contiguous_range Input, std::ranges::contiguous_range Output, typename Fn>
+        requires (std::ranges::sized_range<Input> && std::ranges::sized_range<Output>)
+    void parallel_transform(const Input & input, Output && output, Fn fn, const parallel_options options = {}) {
+        using In = std::remove_cvref_t<std::ranges::range_reference_t<const Input>>;
+        using Out = std::remove_reference_t<std::ranges::range_reference_t<Output>>;
+        const std::span<const In> inputs(std::ranges::data(input), std::ranges::size(input));
+        const std::span<Out> outputs(std::ranges::data(output), std::ranges::size(output));
+
+        if (!check<std::out_of_range, Policy>(outputs.size() >= inputs.size(), "Output is smaller than the input")) [[unlikely]] {
+            return;
+        }
+
+        detail::parallel_chunks(inputs.size(), options, [&](const size_t begin, const size_t end, size_t) {
+            for (size_t i = begin; i < end; ++i) {
+                outputs[i] = fn(ref<In>::create_from(inputs[i]));
+            }
+        });
+    }
+
+    /**
+     * Combines all elements with op on the parallel pool. Every chunk is reduced on its own and the partial results
+     * are combined in chunk order, so op has to be associative but doesn't need to be commutative.
+     * @param range A contiguous range with the values.
+     * @param init The value the reduction starts with.
+     * @param op Called as op(T, T).
+     * @param options The grain size and the number of workers.
+     * @return op(...op(op(init, range[0]), range[1])..., range[n - 1]), grouped per chunk.
+     */
+    template<std::ranges::contiguous_range Range, typename T, typename Op>
+        requires std::ranges::sized_range<Range>
+    [[nodiscard]] T parallel_reduce(const Range & range, T init, Op op, const parallel_options options = {}) {
+        using Value = std::remove_cvref_t<std::ranges::range_reference_t<const Range>>;
+        const std::span<const Value> values(std::ranges::data(range), std::ranges::size(range));
+        if (values.empty()) return init;
+
+        const size_t grain = detail::parallel_grain(values.size(), options);
+        std::vector<std::optional<T>> partials((values.size() + grain - 1) / grain);
+
+        detail::parallel_chunks(values.size(), { grain, options.workers }, [&](const size_t begin, const size_t end, const size_t chunk) {
+            T partial = static_cast<T>(values[begin]);
+            for (size_t i = begin + 1; i < end; ++i) {
+                partial = op(std::move(partial), static_cast<T>(values[i]));
+            }
+            partials[chunk].emplace(std::move(partial));
+        });
+
+        for (auto & partial : partials) {
+            init = op(std::move(init), std::move(*partial));
+        }
+        return init;
+    }
+}
+
+#endif //PARALLEL_HPP
@@ -0,0 +1,238 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Laurens Ruijtenberg
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+#ifndef POOL_HPP
+#define POOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "cache_line.hpp"
+#include "check.hpp"
+
+namespace safe {
+
+    template<typename T, size_t N>
+    class pool;
+
+    namespace detail {
+        /* Every slot starts on its own cache line, so objects that are used by different
+         * parts of the code never share a line with the bookkeeping of a neighbouring slot. */
+        template<typename T>
+        struct alignas(cache_line_size > alignof(T) ? cache_line_size : alignof(T)) pool_slot {
+            alignas(T) std::byte storage[sizeof(T)];
+            uint32_t generation = 0;
+            uint32_t next_free = 0;
+            bool alive = false;
+
+            [[nodiscard]] T * object() {
+                return std::launder(reinterpret_cast<T *>(storage));
+            }
+        };
+    }
+
+    /**
+     * A handle to an object that lives in a safe::pool. It uses the same vocabulary as safe::ptr<T>,
+     * but instead of pointing to a unique_ptr it points to a pool slot plus the generation of that slot.
+     * When the object is destroyed the generation of the slot changes, so every handle that still refers
+     * to it becomes invalid, even when the slot gets reused for a new object.
+     *
+     * @note A handle points straight into the slots of its pool, so the pool has to outlive all of its handles.
+     * Using a handle after its pool was destroyed, even just is_valid(), reads freed memory. Keep handles in
+     * objects which are owned by the pool's owner, or use safe::slot_map whose handles are plain indices.
+     */
+    template<typename T>
+    class pool_ptr {
+        template<typename, size_t>
+        friend class pool;
+
+        detail::pool_slot<T> * _slot;
+        uint32_t _generation;
+
+        template<typename Policy = default_check>
+        [[nodiscard]] constexpr T & checked_object() const {
+            if (!check<std::out_of_range, Policy>(is_valid(), "Pooled object was destroyed", check_site::ptr_is_valid)) [[unlikely]] {
+                //a zeroed value is only a safe fallback for trivially copyable types, anything else has none
+                if constexpr (std::is_trivially_copyable_v<T>) {
+                    return *detail::check_fallback<T>();
+                } else {
+                    detail::check_abort("Pooled object was destroyed");
+                }
+            }
+            return *_slot->object();
+        }
+
+    protected:
+        constexpr pool_ptr() : _slot(nullptr), _generation(0) {}
+        constexpr pool_ptr(detail::pool_slot<T> * slot, const uint32_t generation) : _slot(slot), _generation(generation) {}
+    public:
+        static pool_ptr<T> create_empty() {
+            return pool_ptr<T>();
+        }
+
+        /* We allow copying, the object itself is owned by the pool and every copy can check its validity */
+        constexpr pool_ptr(const pool_ptr<T> &other) = default;
+        constexpr pool_ptr<T> & operator=(const pool_ptr<T> &other) = default;
+
+        /**
+         * @return A pointer to the pooled object.
+         * @throws std::out_of_range if the object was destroyed.
+         */
+        [[nodiscard]] constexpr T * operator->() const {
+            return &checked_object();
+        }
+
+        [[nodiscard]] constexpr bool is_valid() const {
+            return _slot != nullptr && _slot->alive && _slot->generation == _generation;
+        }
+
+        /**
+         * @return A copy of the pooled object.
+         * @throws std::out_of_range if the object was destroyed.
+         */
+        [[nodiscard]] constexpr T clone() const {
+            return checked_object();
+        }
+
+        /**
+         * @return A pointer to the pooled object, or nullptr if the object was destroyed.
+         */
+        [[nodiscard]] constexpr T * unsafe_pointer() const {
+            return is_valid() ? _slot->object() : nullptr;
+        }
+
+        /**
+         * @throws std::out_of_range if the object was destroyed.
+         */
+        [[nodiscard]] constexpr T & unsafe_reference() const {
+            return checked_object();
+        }
+    };
+
+    /**
+     * A fixed-size slab of N objects of type T. All memory is allocated once when the pool is created,
+     * after that creating and destroying objects only pushes and pops slots on an intrusive free list.
+     * The pool hands out safe::pool_ptr<T> handles and destroys all objects that are still alive when
+     * it goes out of scope itself. It has to outlive every handle it handed out, see safe::pool_ptr.
+     *
+     * @note The pool is not thread-safe. Use one pool per thread to avoid contention altogether.
+     */
+    template<typename T, size_t N>
+    class pool {
+        static_assert(N > 0, "A pool needs at least one slot.");
+        static_assert(N < std::numeric_limits<uint32_t>::max(), "A pool can hold at most 2^32 - 2 objects.");
+
+        static constexpr uint32_t no_slot = std::numeric_limits<uint32_t>::max();
+
+        std::unique_ptr<detail::pool_slot<T>[]> _slots;
+        uint32_t _free_head = 0;
+        size_t _available = N;
+
+    public:
+        pool() : _slots(std::make_unique<detail::pool_slot<T>[]>(N)) {
+            for (uint32_t i = 0; i < N; ++i) {
+                _slots[i].next_free = (i + 1 < N) ? i + 1 : no_slot;
+            }
+        }
+
+        ~pool() {
+            if (_slots == nullptr) return;
+
+            for (size_t i = 0; i < N; ++i) {
+                if (_slots[i].alive) {
+                    std::destroy_at(_slots[i].object());
+                }
+            }
+        }
+
+        /* Handles point into the slots, so the pool can't be copied or moved */
+        pool(const pool &other) = delete;
+        pool(pool &&other) noexcept = delete;
+        pool & operator=(const pool &other) = delete;
+        pool & operator=(pool &&other) noexcept = delete;
+
+        /**
+         * @return The number of objects the pool can hold.
+         */
+        [[nodiscard]] static constexpr size_t capacity() { return N; }
+
+        /**
+         * @return The number of free slots.
+         */
+        [[nodiscard]] constexpr size_t available() const { return _available; }
+
+        /**
+         * Constructs a new object in a free slot.
+         * @param args The arguments that are forwarded to the constructor of T.
+         * @throws std::bad_alloc if all slots are in use.
+         * @return A handle to the new object, or an empty handle when all slots are in use and the check policy continues.
+         */
+        template<typename Policy = default_check, typename... Args>
+        [[nodiscard]] pool_ptr<T> create(Args&&... args) {
+            if (!check_always<std::bad_alloc, Policy>(_free_head != no_slot, "Pool is full")) [[unlikely]] {
+                return pool_ptr<T>::create_empty();
+            }
+
+            auto & slot = _slots[_free_head];
+            std::construct_at(reinterpret_cast<T *>(slot.storage), std::forward<Args>(args)...);
+
+            _free_head = slot.next_free;
+            slot.alive = true;
+            --_available;
+
+            return pool_ptr<T>(&slot, slot.generation);
+        }
+
+        /**
+         * Destroys the object the handle refers to and returns its slot to the pool. All handles
+         * to the object become invalid.
+         * @return False if the handle was already invalid or doesn't belong to this pool.
+         */
+        bool destroy(const pool_ptr<T> & handle) {
+            if (!handle.is_valid() || handle._slot < _slots.get() || handle._slot >= _slots.get() + N) {
+                return false;
+            }
+
+            auto & slot = *handle._slot;
+            std::destroy_at(slot.object());
+
+            slot.alive = false;
+            ++slot.generation;
+            slot.next_free = _free_head;
+            _free_head = static_cast<uint32_t>(&slot - _slots.get());
+            ++_available;
+
+            return true;
+        }
+    };
+}
+
+#endif //POOL_HPP
@@ -28,6 +28,8 @@
 
 #include <memory>
 
+#include "telemetry.hpp"
+
 namespace safe {
 
     template<typename T>
@@ -79,7 +81,9 @@ namespace safe {
         }
 
         [[nodiscard]] constexpr bool is_valid() const {
-            return _ptr != nullptr;
+            const bool valid = _ptr != nullptr;
+            detail::telemetry_record_check(check_site::ptr_is_valid, valid);
+            return valid;
         }
 
         [[nodiscard]] constexpr T clone() const {
@@ -148,7 +152,9 @@ namespace safe {
         }
 
         [[nodiscard]] constexpr bool is_valid() const {
-            return _ptr != nullptr && _ptr->get() != nullptr;;
+            const bool valid = _ptr != nullptr && _ptr->get() != nullptr;
+            detail::telemetry_record_check(check_site::ptr_is_valid, valid);
+            return valid;
         }
 
         [[nodiscard]] constexpr T clone() const {
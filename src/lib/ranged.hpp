@@ -26,71 +26,328 @@
 #ifndef RANGE_HPP
 #define RANGE_HPP
 
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <span>
 #include <stdexcept>
 #include <type_traits>
 
 #include "common_operators.hpp"
+#include "check.hpp"
+#include "result.hpp"
+#include "simd.hpp"
 
 namespace safe {
+
+    namespace detail {
+        /* Overflow checks which are evaluated at compile time on the bounds of ranged types */
+        template<typename T>
+        constexpr bool add_fits(const T a, const T b) {
+            if constexpr (std::is_floating_point_v<T>) return true;
+            else return b >= 0 ? a <= std::numeric_limits<T>::max() - b : a >= std::numeric_limits<T>::min() - b;
+        }
+
+        template<typename T>
+        constexpr bool sub_fits(const T a, const T b) {
+            if constexpr (std::is_floating_point_v<T>) return true;
+            else return b >= 0 ? a >= std::numeric_limits<T>::min() + b : a <= std::numeric_limits<T>::max() + b;
+        }
+
+        template<typename T>
+        constexpr bool mul_fits(const T a, const T b) {
+            if constexpr (std::is_floating_point_v<T>) return true;
+            else {
+                if (a == 0 || b == 0) return true;
+                if (a > 0) return b > 0 ? a <= std::numeric_limits<T>::max() / b : b >= std::numeric_limits<T>::min() / a;
+                return b > 0 ? a >= std::numeric_limits<T>::min() / b : a >= std::numeric_limits<T>::max() / b;
+            }
+        }
+
+        template<typename T>
+        constexpr bool div_fits(const T a, const T b) {
+            if constexpr (std::is_signed_v<T> && std::is_integral_v<T>) return !(a == std::numeric_limits<T>::min() && b == -1);
+            else return true;
+        }
+
+        /* The default of a computed range, T{} when it fits and the closest bound otherwise */
+        template<typename T>
+        constexpr T default_within(const T from, const T to) {
+            return T{} < from ? from : (T{} > to ? to : T{});
+        }
+
+        template<typename T>
+        constexpr T min_of(const T a, const T b, const T c, const T d) {
+            return std::min(std::min(a, b), std::min(c, d));
+        }
+
+        template<typename T>
+        constexpr T max_of(const T a, const T b, const T c, const T d) {
+            return std::max(std::max(a, b), std::max(c, d));
+        }
+    }
+
     template<typename T, T TFrom, T TTo, T TDefault = T{}>
-    class ranged : public common_operators_unmutable<T> {
+    class ranged {
         static_assert(TDefault >= TFrom && TDefault <= TTo, "TDefault must be within the range [TFrom, TTo]");
         static_assert(std::is_arithmetic_v<T>, "Type T must be an arithmetic type (integral or floating point)");
         static_assert(TFrom < TTo, "TFrom must be less than TTo");
-        
+
+        //all ranged types may create each other without a check when the bounds prove that the value fits
+        template<typename U, U UFrom, U UTo, U UDefault>
+        friend class ranged;
+
+        template<typename U, U UFrom, U UTo>
+        friend class ranged_span;
+
+        template<T TFromResult, T TToResult>
+        using ranged_result = ranged<T, TFromResult, TToResult, detail::default_within(TFromResult, TToResult)>;
+
         T _data;
+
+        struct already_checked {};
+        constexpr ranged(T value, already_checked) : _data(value) {}
+
+        //runs the range check through the check policy, when it continues the value is clamped so the invariant still holds
+        static constexpr T checked(const T value) {
+            if (!check<std::out_of_range>(value >= TFrom && value <= TTo, "Value is out of range", check_site::ranged_construct)) [[unlikely]] {
+                detail::telemetry_record_clamp(check_site::ranged_construct);
+                return !(value >= TFrom) ? TFrom : TTo;
+            }
+            return value;
+        }
     
     public:
-        constexpr ranged(T value = TDefault) : _data(value) {
-            if (value < TFrom || value > TTo) {
-                throw std::out_of_range("Value is out of range");
+        constexpr ranged(T value = TDefault) : _data(checked(value)) {
+        }
+
+        /**
+         * The non-throwing counterpart of the constructor.
+         * @return A ranged with the given value, or error_code::out_of_range if the value doesn't fit in the range.
+         */
+        [[nodiscard]] static constexpr result<ranged, error_code> try_create(T value) noexcept {
+            if (value < TFrom || value > TTo) [[unlikely]] {
+                return failure(error_code::out_of_range);
             }
+            return ranged(value, already_checked{});
         }
         
-        constexpr ranged(const ranged<T, TFrom, TTo> &other) : _data(other._data) {
+        constexpr ranged(const ranged &other) : _data(other._data) {
             //no additional checks needed, as the value is already validated
         }
         
-        constexpr ranged& operator=(const ranged<T, TFrom, TTo> &other) {
+        constexpr ranged& operator=(const ranged &other) {
             if (this != &other) {
                   _data = other._data;
             }
             return *this;
         }
 
-        template<T TFromOther, T TToOther>
-        constexpr ranged(const ranged<T, TFromOther, TToOther> &other) : _data(other.value()) {
-            if (other.value() < TFrom || other.value() > TTo) {
-                throw std::out_of_range("Value is out of range");
+        //only a narrowing conversion needs a check, when the other range fits in ours the value is already valid
+        template<T TFromOther, T TToOther, T TDefaultOther>
+        constexpr ranged(const ranged<T, TFromOther, TToOther, TDefaultOther> &other) : _data(other._data) {
+            if constexpr (TFromOther < TFrom || TToOther > TTo) {
+                _data = checked(other._data);
             }
         }
         
-        template<T TFromOther, T TToOther>
-        [[nodiscard]] constexpr ranged& operator=(const ranged<T, TFromOther, TToOther> &other) {
-            if (this != &other) {
-                if (_data < TFrom || _data > TTo) {
-                    throw std::out_of_range("Value is out of range");
-                }
-                
-                _data = other.value();
+        template<T TFromOther, T TToOther, T TDefaultOther>
+        constexpr ranged& operator=(const ranged<T, TFromOther, TToOther, TDefaultOther> &other) {
+            if constexpr (TFromOther < TFrom || TToOther > TTo) {
+                _data = checked(other._data);
+            } else {
+                _data = other._data;
             }
             return *this;
         }
 
+        [[nodiscard]] constexpr T value() const {
+            return _data;
+        }
+
+        /*
+         * Arithmetic between ranged values returns a ranged whose bounds are computed at compile time from the
+         * bounds of both operands, so the result doesn't need a runtime check. Only storing it in a narrower
+         * ranged checks the value. When the bounds could overflow T (or a divisor range contains zero) these
+         * operators don't apply and the values fall back to plain T arithmetic through the implicit conversion.
+         */
+        template<T TFromOther, T TToOther, T TDefaultOther>
+            requires (detail::add_fits(TFrom, TFromOther) && detail::add_fits(TTo, TToOther))
+        [[nodiscard]] constexpr auto operator+(const ranged<T, TFromOther, TToOther, TDefaultOther> &other) const {
+            using result_type = ranged_result<TFrom + TFromOther, TTo + TToOther>;
+            return result_type(static_cast<T>(_data + other._data), typename result_type::already_checked{});
+        }
+
+        template<T TFromOther, T TToOther, T TDefaultOther>
+            requires (detail::sub_fits(TFrom, TToOther) && detail::sub_fits(TTo, TFromOther))
+        [[nodiscard]] constexpr auto operator-(const ranged<T, TFromOther, TToOther, TDefaultOther> &other) const {
+            using result_type = ranged_result<TFrom - TToOther, TTo - TFromOther>;
+            return result_type(static_cast<T>(_data - other._data), typename result_type::already_checked{});
+        }
+
+        template<T TFromOther, T TToOther, T TDefaultOther>
+            requires (detail::mul_fits(TFrom, TFromOther) && detail::mul_fits(TFrom, TToOther)
+                   && detail::mul_fits(TTo, TFromOther) && detail::mul_fits(TTo, TToOther))
+        [[nodiscard]] constexpr auto operator*(const ranged<T, TFromOther, TToOther, TDefaultOther> &other) const {
+            using result_type = ranged_result<
+                detail::min_of<T>(TFrom * TFromOther, TFrom * TToOther, TTo * TFromOther, TTo * TToOther),
+                detail::max_of<T>(TFrom * TFromOther, TFrom * TToOther, TTo * TFromOther, TTo * TToOther)>;
+            return result_type(static_cast<T>(_data * other._data), typename result_type::already_checked{});
+        }
+
+        template<T TFromOther, T TToOther, T TDefaultOther>
+            requires ((TFromOther > 0 || TToOther < 0)
+                   && detail::div_fits(TFrom, TFromOther) && detail::div_fits(TFrom, TToOther)
+                   && detail::div_fits(TTo, TFromOther) && detail::div_fits(TTo, TToOther)
+                   && detail::min_of<T>(TFrom / TFromOther, TFrom / TToOther, TTo / TFromOther, TTo / TToOther)
+                    < detail::max_of<T>(TFrom / TFromOther, TFrom / TToOther, TTo / TFromOther, TTo / TToOther))
+        [[nodiscard]] constexpr auto operator/(const ranged<T, TFromOther, TToOther, TDefaultOther> &other) const {
+            using result_type = ranged_result<
+                detail::min_of<T>(TFrom / TFromOther, TFrom / TToOther, TTo / TFromOther, TTo / TToOther),
+                detail::max_of<T>(TFrom / TFromOther, TFrom / TToOther, TTo / TFromOther, TTo / TToOther)>;
+            return result_type(static_cast<T>(_data / other._data), typename result_type::already_checked{});
+        }
+
+        [[nodiscard]] constexpr auto operator-() const
+            requires (std::is_signed_v<T> && detail::sub_fits(T{}, TFrom) && detail::sub_fits(T{}, TTo)) {
+            using result_type = ranged_result<static_cast<T>(-TTo), static_cast<T>(-TFrom)>;
+            return result_type(static_cast<T>(-_data), typename result_type::already_checked{});
+        }
+
         //this is allowed in this case because we are dealing with numerical values only.
         [[nodiscard]] constexpr operator const T() const {
             return _data;
         }
 
-        [[nodiscard]] constexpr bool operator==(const ranged<T, TFrom, TTo> &other) const {
+        [[nodiscard]] constexpr bool operator==(const ranged &other) const {
             return _data == other._data;
         }
 
-        [[nodiscard]] constexpr bool operator!=(const ranged<T, TFrom, TTo> &other) const {
+        [[nodiscard]] constexpr bool operator!=(const ranged &other) const {
             return !(*this == other);
         }
     };
 
+    /**
+     * A view over contiguous values which are all known to be within [TFrom, TTo]. It is created by validate_range or
+     * clamp_range, which check the whole span at once, so reading the elements as ranged doesn't check them again.
+     * Like std::span, the view doesn't own the values and must not outlive them.
+     */
+    template<typename T, T TFrom, T TTo>
+    class ranged_span {
+    public:
+        using element_type = ranged<T, TFrom, TTo, detail::default_within(TFrom, TTo)>;
+
+        class iterator {
+            const T *_current = nullptr;
+
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = element_type;
+            using difference_type = std::ptrdiff_t;
+
+            constexpr iterator() = default;
+            constexpr explicit iterator(const T *current) : _current(current) {}
+
+            [[nodiscard]] constexpr element_type operator*() const {
+                return element_type(*_current, typename element_type::already_checked{});
+            }
+
+            [[nodiscard]] constexpr element_type operator[](const difference_type n) const {
+                return *(*this + n);
+            }
+
+            constexpr iterator& operator++() { ++_current; return *this; }
+            constexpr iterator operator++(int) { iterator copy = *this; ++_current; return copy; }
+            constexpr iterator& operator--() { --_current; return *this; }
+            constexpr iterator operator--(int) { iterator copy = *this; --_current; return copy; }
+            constexpr iterator& operator+=(const difference_type n) { _current += n; return *this; }
+            constexpr iterator& operator-=(const difference_type n) { _current -= n; return *this; }
+
+            [[nodiscard]] constexpr friend iterator operator+(iterator it, const difference_type n) { return it += n; }
+            [[nodiscard]] constexpr friend iterator operator+(const difference_type n, iterator it) { return it += n; }
+            [[nodiscard]] constexpr friend iterator operator-(iterator it, const difference_type n) { return it -= n; }
+            [[nodiscard]] constexpr friend difference_type operator-(const iterator &a, const iterator &b) { return a._current - b._current; }
+            [[nodiscard]] constexpr friend auto operator<=>(const iterator &a, const iterator &b) = default;
+        };
+
+    private:
+        std::span<const T> _values;
+
+        struct already_checked {};
+        constexpr ranged_span(std::span<const T> values, already_checked) : _values(values) {}
+
+        template<auto UFrom, decltype(UFrom) UTo>
+        friend result<ranged_span<decltype(UFrom), UFrom, UTo>, error_code> validate_range(std::span<const decltype(UFrom)> values) noexcept;
+
+        template<auto UFrom, decltype(UFrom) UTo>
+        friend ranged_span<decltype(UFrom), UFrom, UTo> clamp_range(std::span<decltype(UFrom)> values) noexcept;
+
+    public:
+        constexpr ranged_span() = default;
+
+        [[nodiscard]] constexpr size_t size() const {
+            return _values.size();
+        }
+
+        [[nodiscard]] constexpr bool empty() const {
+            return _values.empty();
+        }
+
+        /**
+         * @param index The index of the element.
+         * @return The element as a ranged without checking its value again.
+         * @throws std::out_of_range if the index is out of bounds.
+         */
+        [[nodiscard]] constexpr element_type get(const size_t index) const {
+            if (!check<std::out_of_range>(index < _values.size(), "Index out of bounds")) [[unlikely]] {
+                return element_type();
+            }
+            return element_type(_values[index], typename element_type::already_checked{});
+        }
+
+        /**
+         * @return The underlying values, which are all within [TFrom, TTo].
+         */
+        [[nodiscard]] constexpr std::span<const T> values() const {
+            return _values;
+        }
+
+        [[nodiscard]] constexpr iterator begin() const {
+            return iterator(_values.data());
+        }
+
+        [[nodiscard]] constexpr iterator end() const {
+            return iterator(_values.data() + _values.size());
+        }
+    };
+
+    /**
+     * Checks all values at once with the widest SIMD kernel the CPU supports. NaN is never within range.
+     * @param values The values to validate.
+     * @return A view over the values, or error_code::out_of_range if any value is outside of [TFrom, TTo].
+     */
+    template<auto TFrom, decltype(TFrom) TTo>
+    [[nodiscard]] result<ranged_span<decltype(TFrom), TFrom, TTo>, error_code> validate_range(std::span<const decltype(TFrom)> values) noexcept {
+        using span_type = ranged_span<decltype(TFrom), TFrom, TTo>;
+        if (!detail::simd::all_within(values.data(), values.size(), TFrom, TTo)) [[unlikely]] {
+            return failure(error_code::out_of_range);
+        }
+        return span_type(values, typename span_type::already_checked{});
+    }
+
+    /**
+     * Clamps all values to [TFrom, TTo] in place with the widest SIMD kernel the CPU supports. NaN is clamped to TFrom.
+     * @param values The values to clamp.
+     * @return A view over the clamped values.
+     */
+    template<auto TFrom, decltype(TFrom) TTo>
+    ranged_span<decltype(TFrom), TFrom, TTo> clamp_range(std::span<decltype(TFrom)> values) noexcept {
+        using span_type = ranged_span<decltype(TFrom), TFrom, TTo>;
+        detail::simd::clamp(values.data(), values.size(), TFrom, TTo);
+        return span_type(std::span<const decltype(TFrom)>(values), typename span_type::already_checked{});
+    }
+
         template<typename T, T TFrom, T TTo, T TDefault = T{}>
     class ranged_clamped : public common_operators_unmutable<T> {
         static_assert(TDefault >= TFrom && TDefault <= TTo, "TDefault must be within the range [TFrom, TTo]");
@@ -98,9 +355,18 @@ namespace safe {
         static_assert(TFrom < TTo, "TFrom must be less than TTo");
         
         T _data;
+
+        static constexpr T clamped(const T value) {
+            const T result = std::min(std::max(value, TFrom), TTo);
+            detail::telemetry_record_check(check_site::ranged_clamped, result == value);
+            if (result != value) [[unlikely]] {
+                detail::telemetry_record_clamp(check_site::ranged_clamped);
+            }
+            return result;
+        }
     
     public:
-        constexpr ranged_clamped(T value = TDefault) : _data(std::min(std::max(value, TFrom), TTo)) {
+        constexpr ranged_clamped(T value = TDefault) : _data(clamped(value)) {
         }
         
         constexpr ranged_clamped(const ranged_clamped<T, TFrom, TTo> &other) : _data(other._data) {
@@ -115,13 +381,13 @@ namespace safe {
         }
 
         template<T TFromOther, T TToOther>
-        constexpr ranged_clamped(const ranged<T, TFromOther, TToOther> &other) : _data(std::min(std::max(other._data, TFrom), TTo)) {
+        constexpr ranged_clamped(const ranged<T, TFromOther, TToOther> &other) : _data(clamped(other.value())) {
         }
         
         template<T TFromOther, T TToOther>
         [[nodiscard]] constexpr ranged_clamped& operator=(const ranged_clamped<T, TFromOther, TToOther> &other) {
             if (this != &other) {
-                _data = std::min(std::max(other._data, TFrom), TTo);
+                _data = clamped(other._data);
             }
             return *this;
         }
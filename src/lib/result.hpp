@@ -0,0 +1,346 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Laurens Ruijtenberg
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+#ifndef RESULT_HPP
+#define RESULT_HPP
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "ptr.hpp"
+
+namespace safe {
+
+    /* The errors which are reported by the non-throwing try_ methods of the framework */
+    enum class error_code : uint8_t {
+        out_of_bounds,     //an offset or index falls outside of a memory block or container
+        out_of_range,      //a value falls outside of the range of a ranged type
+        invalid_reference  //the referenced object or container no longer exists
+    };
+
+    /**
+     * Wraps an error so it can be implicitly converted to a failed safe::result.
+     */
+    template<typename E>
+    class failure {
+        E _error;
+    public:
+        constexpr explicit failure(const E & error) : _error(error) {}
+        constexpr explicit failure(E && error) : _error(std::move(error)) {}
+
+        [[nodiscard]] constexpr const E & error() const & { return _error; }
+        [[nodiscard]] constexpr E && error() && { return std::move(_error); }
+    };
+
+    template<typename E>
+    failure(E) -> failure<E>;
+
+    /**
+     * Describes a value of T which can never be a valid success value, so a safe::result with an empty
+     * error type can use it to mark the failure without any extra storage. Specialize it to opt a type in.
+     */
+    template<typename T>
+    struct niche_traits {
+        static constexpr bool available = false;
+    };
+
+    template<typename T>
+    struct niche_traits<ref_ptr<T>> {
+        static constexpr bool available = true;
+
+        [[nodiscard]] static constexpr ref_ptr<T> none() { return ref_ptr<T>(); }
+        [[nodiscard]] static constexpr bool is_none(const ref_ptr<T> & value) { return value.unsafe_pointer() == nullptr; }
+    };
+
+    template<typename T, typename E>
+    class result;
+
+    namespace detail {
+        template<typename R>
+        struct is_result : std::false_type {};
+
+        template<typename T, typename E>
+        struct is_result<result<T, E>> : std::true_type {};
+
+        [[noreturn]] inline void bad_result_access() {
+            //results are meant to be usable without exceptions, so an unchecked access to the wrong state is fatal
+            std::abort();
+        }
+    }
+
+    /**
+     * The return type of an operation which can fail, without using exceptions. It either holds a value
+     * of type T or an error of type E. It offers the monadic and_then/transform/or_else operations to
+     * chain operations without checking every intermediate result.
+     *
+     * Accessing the value of a failed result (or the error of a successful one) terminates the program,
+     * check has_value() first or use value_or().
+     */
+    template<typename T, typename E>
+    class result {
+        static_assert(!std::is_reference_v<T> && !std::is_reference_v<E>, "A result can't hold references, use safe::ref_ptr instead.");
+
+        union {
+            T _value;
+            E _error;
+        };
+        bool _has_value;
+
+    public:
+        using value_type = T;
+        using error_type = E;
+
+        constexpr result(const T & value) : _value(value), _has_value(true) {}
+        constexpr result(T && value) noexcept(std::is_nothrow_move_constructible_v<T>) : _value(std::move(value)), _has_value(true) {}
+
+        template<typename G> requires std::is_constructible_v<E, const G &>
+        constexpr result(const failure<G> & error) : _error(error.error()), _has_value(false) {}
+
+        template<typename G> requires std::is_constructible_v<E, G &&>
+        constexpr result(failure<G> && error) : _error(std::move(error).error()), _has_value(false) {}
+
+        constexpr result(const result & other) requires (std::is_copy_constructible_v<T> && std::is_copy_constructible_v<E>) : _has_value(other._has_value) {
+            if (_has_value) std::construct_at(&_value, other._value);
+            else std::construct_at(&_error, other._error);
+        }
+
+        constexpr result(result && other) noexcept(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_constructible_v<E>)
+            requires (std::is_move_constructible_v<T> && std::is_move_constructible_v<E>) : _has_value(other._has_value) {
+            if (_has_value) std::construct_at(&_value, std::move(other._value));
+            else std::construct_at(&_error, std::move(other._error));
+        }
+
+        /* Assignment between a value and an error destroys one and constructs the other in place, which is only
+         * safe when that can't throw halfway, so it needs T and E to be nothrow move constructible. The void and
+         * niche results are assignable as well. */
+        constexpr result & operator=(const result & other)
+            requires (std::is_copy_constructible_v<T> && std::is_copy_constructible_v<E> && std::is_copy_assignable_v<T> && std::is_copy_assignable_v<E>
+                      && std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_constructible_v<E>) {
+            if (_has_value && other._has_value) {
+                _value = other._value;
+            } else if (!_has_value && !other._has_value) {
+                _error = other._error;
+            } else {
+                result copy(other);
+                *this = std::move(copy);
+            }
+            return *this;
+        }
+
+        constexpr result & operator=(result && other) noexcept(std::is_nothrow_move_assignable_v<T> && std::is_nothrow_move_assignable_v<E>)
+            requires (std::is_move_assignable_v<T> && std::is_move_assignable_v<E>
+                      && std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_constructible_v<E>) {
+            if (_has_value && other._has_value) {
+                _value = std::move(other._value);
+            } else if (!_has_value && !other._has_value) {
+                _error = std::move(other._error);
+            } else if (other._has_value) {
+                std::destroy_at(&_error);
+                std::construct_at(&_value, std::move(other._value));
+                _has_value = true;
+            } else {
+                std::destroy_at(&_value);
+                std::construct_at(&_error, std::move(other._error));
+                _has_value = false;
+            }
+            return *this;
+        }
+
+        constexpr ~result() requires (std::is_trivially_destructible_v<T> && std::is_trivially_destructible_v<E>) = default;
+
+        constexpr ~result() {
+            if (_has_value) std::destroy_at(&_value);
+            else std::destroy_at(&_error);
+        }
+
+        [[nodiscard]] constexpr bool has_value() const { return _has_value; }
+        [[nodiscard]] constexpr bool has_error() const { return !_has_value; }
+        [[nodiscard]] constexpr explicit operator bool() const { return _has_value; }
+
+        [[nodiscard]] constexpr const T & value() const & {
+            if (!_has_value) [[unlikely]] detail::bad_result_access();
+            return _value;
+        }
+
+        [[nodiscard]] constexpr T value() && {
+            if (!_has_value) [[unlikely]] detail::bad_result_access();
+            return std::move(_value);
+        }
+
+        [[nodiscard]] constexpr const E & error() const & {
+            if (_has_value) [[unlikely]] detail::bad_result_access();
+            return _error;
+        }
+
+        [[nodiscard]] constexpr T value_or(const T & fallback) const & {
+            return _has_value ? _value : fallback;
+        }
+
+        [[nodiscard]] constexpr T value_or(const T & fallback) && {
+            return _has_value ? std::move(_value) : fallback;
+        }
+
+        /**
+         * Calls f with the value when there is one. f must return a result with the same error type.
+         */
+        template<typename F>
+        [[nodiscard]] constexpr auto and_then(F && f) const & {
+            using R = std::remove_cvref_t<std::invoke_result_t<F, const T &>>;
+            static_assert(detail::is_result<R>::value && std::is_same_v<typename R::error_type, E>, "and_then must return a result with the same error type.");
+            if (_has_value) return std::forward<F>(f)(_value);
+            return R(failure<E>(_error));
+        }
+
+        /**
+         * Calls f with the value when there is one and wraps what f returns in a new result.
+         */
+        template<typename F>
+        [[nodiscard]] constexpr auto transform(F && f) const & {
+            using U = std::remove_cvref_t<std::invoke_result_t<F, const T &>>;
+            if (_has_value) return result<U, E>(std::forward<F>(f)(_value));
+            return result<U, E>(failure<E>(_error));
+        }
+
+        /**
+         * Calls f with the error when there is one, so it can recover or map it to another error.
+         * f must return a result with the same value type.
+         */
+        template<typename F>
+        [[nodiscard]] constexpr auto or_else(F && f) const & {
+            using R = std::remove_cvref_t<std::invoke_result_t<F, const E &>>;
+            static_assert(detail::is_result<R>::value && std::is_same_v<typename R::value_type, T>, "or_else must return a result with the same value type.");
+            if (_has_value) return R(_value);
+            return std::forward<F>(f)(_error);
+        }
+    };
+
+    /**
+     * A result for an operation which doesn't produce a value.
+     */
+    template<typename E>
+    class result<void, E> {
+        E _error {};
+        bool _has_value = true;
+
+    public:
+        using value_type = void;
+        using error_type = E;
+
+        constexpr result() = default;
+
+        template<typename G> requires std::is_constructible_v<E, const G &>
+        constexpr result(const failure<G> & error) : _error(error.error()), _has_value(false) {}
+
+        [[nodiscard]] constexpr bool has_value() const { return _has_value; }
+        [[nodiscard]] constexpr bool has_error() const { return !_has_value; }
+        [[nodiscard]] constexpr explicit operator bool() const { return _has_value; }
+
+        [[nodiscard]] constexpr const E & error() const {
+            if (_has_value) [[unlikely]] detail::bad_result_access();
+            return _error;
+        }
+
+        template<typename F>
+        [[nodiscard]] constexpr auto and_then(F && f) const {
+            using R = std::remove_cvref_t<std::invoke_result_t<F>>;
+            static_assert(detail::is_result<R>::value && std::is_same_v<typename R::error_type, E>, "and_then must return a result with the same error type.");
+            if (_has_value) return std::forward<F>(f)();
+            return R(failure<E>(_error));
+        }
+
+        template<typename F>
+        [[nodiscard]] constexpr auto or_else(F && f) const {
+            using R = std::remove_cvref_t<std::invoke_result_t<F, const E &>>;
+            if (_has_value) return R();
+            return std::forward<F>(f)(_error);
+        }
+    };
+
+    /**
+     * A result whose error type carries no information and whose value type has a niche: the failure is
+     * stored as the niche value of T, so the result is exactly as large as T itself.
+     */
+    template<typename T, typename E> requires (std::is_empty_v<E> && niche_traits<T>::available)
+    class result<T, E> {
+        T _value;
+
+    public:
+        using value_type = T;
+        using error_type = E;
+
+        constexpr result(const T & value) : _value(value) {
+            if (niche_traits<T>::is_none(_value)) [[unlikely]] detail::bad_result_access();
+        }
+
+        template<typename G> requires std::is_constructible_v<E, const G &>
+        constexpr result(const failure<G> &) : _value(niche_traits<T>::none()) {}
+
+        [[nodiscard]] constexpr bool has_value() const { return !niche_traits<T>::is_none(_value); }
+        [[nodiscard]] constexpr bool has_error() const { return !has_value(); }
+        [[nodiscard]] constexpr explicit operator bool() const { return has_value(); }
+
+        [[nodiscard]] constexpr const T & value() const {
+            if (!has_value()) [[unlikely]] detail::bad_result_access();
+            return _value;
+        }
+
+        [[nodiscard]] constexpr E error() const {
+            if (has_value()) [[unlikely]] detail::bad_result_access();
+            return E{};
+        }
+
+        [[nodiscard]] constexpr T value_or(const T & fallback) const {
+            return has_value() ? _value : fallback;
+        }
+
+        template<typename F>
+        [[nodiscard]] constexpr auto and_then(F && f) const {
+            using R = std::remove_cvref_t<std::invoke_result_t<F, const T &>>;
+            static_assert(detail::is_result<R>::value && std::is_same_v<typename R::error_type, E>, "and_then must return a result with the same error type.");
+            if (has_value()) return std::forward<F>(f)(_value);
+            return R(failure<E>(E{}));
+        }
+
+        template<typename F>
+        [[nodiscard]] constexpr auto transform(F && f) const {
+            using U = std::remove_cvref_t<std::invoke_result_t<F, const T &>>;
+            if (has_value()) return result<U, E>(std::forward<F>(f)(_value));
+            return result<U, E>(failure<E>(E{}));
+        }
+
+        template<typename F>
+        [[nodiscard]] constexpr auto or_else(F && f) const {
+            using R = std::remove_cvref_t<std::invoke_result_t<F, const E &>>;
+            static_assert(detail::is_result<R>::value && std::is_same_v<typename R::value_type, T>, "or_else must return a result with the same value type.");
+            if (has_value()) return R(_value);
+            return std::forward<F>(f)(E{});
+        }
+    };
+}
+
+#endif //RESULT_HPP
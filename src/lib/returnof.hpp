@@ -27,6 +27,7 @@
 #define RETURNOF_HPP
 
 #include <type_traits>
+#include <utility>
 
 #include "owner.hpp"
 
@@ -54,11 +55,17 @@ namespace safe {
             return *this;
         }
 
-        [[nodiscard]] constexpr operator owner<T>() const {
+        [[nodiscard]] constexpr operator owner<T>() const & {
             static_assert(!std::is_same_v<T, safe::ref<T>> && !std::is_same_v<T, safe::mut<T>>, "This return value contains either a reference or mutable reference. As such ownership cannot be transferred over.");
             return _value;
         }
 
+        //when the return_of is a temporary the payload is moved into the owner instead of copied
+        [[nodiscard]] constexpr operator owner<T>() && {
+            static_assert(!std::is_same_v<T, safe::ref<T>> && !std::is_same_v<T, safe::mut<T>>, "This return value contains either a reference or mutable reference. As such ownership cannot be transferred over.");
+            return safe::owner<T>(std::move(_value));
+        }
+
         [[nodiscard]] constexpr operator ref<T>() const {
             return safe::ref<T>::create_from(_value);;
         }
@@ -67,11 +74,19 @@ namespace safe {
             return safe::mut<T>::create_from(_value);;
         }
 
-        [[nodiscard]] constexpr owner<T> owner() const requires (!std::is_same_v<T, safe::ref<T>> && !std::is_same_v<T, safe::mut<T>>) {
+        [[nodiscard]] constexpr owner<T> owner() const & requires (!std::is_same_v<T, safe::ref<T>> && !std::is_same_v<T, safe::mut<T>>) {
             static_assert(!std::is_same_v<T, safe::ref<T>> && !std::is_same_v<T, safe::mut<T>>, "This return value contains either a reference or mutable reference. As such ownership cannot be transferred over.");
             return _value;
         }
 
+        /**
+         * Consumes the return value, the payload is moved into the owner instead of copied.
+         * Use it as std::move(result).owner() or directly on the returned temporary.
+         */
+        [[nodiscard]] constexpr safe::owner<T> owner() && requires (!std::is_same_v<T, safe::ref<T>> && !std::is_same_v<T, safe::mut<T>>) {
+            return safe::owner<T>(std::move(_value));
+        }
+
         [[nodiscard]] constexpr ref<T> ref() {
             return safe::ref<T>::create_from(_value);
         }
@@ -80,10 +95,17 @@ namespace safe {
             return safe::mut<T>::create_from(_value);
         }
 
-        [[nodiscard]] constexpr T value() {
+        [[nodiscard]] constexpr T value() const & {
             return _value;
         }
 
+        /**
+         * Consumes the return value, the payload is moved out instead of copied.
+         */
+        [[nodiscard]] constexpr T value() && {
+            return std::move(_value);
+        }
+
         [[nodiscard]] T unsafe_get() const {
             return _value;
         }
@@ -0,0 +1,351 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Laurens Ruijtenberg
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+#ifndef RING_HPP
+#define RING_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+#include "cache_line.hpp"
+#include "check.hpp"
+
+namespace safe {
+
+    enum class ring_mode {
+        spsc, //one producer thread and one consumer thread
+        mpmc  //any number of producer and consumer threads
+    };
+
+    /**
+     * A bounded, lock-free ring buffer for exactly one producer thread and one consumer thread.
+     * Head and tail live on their own cache lines, and each side keeps a cached copy of the other side's
+     * counter so it only touches the shared line when the ring looks full or empty.
+     *
+     * Besides pushing and popping single values and batches, the producer can claim() a writable region of
+     * the ring and commit() it once it is filled, and the consumer can peek() at a readable region and
+     * consume() it. Those regions are handed out as bounds-checked spans, so nothing is copied twice.
+     */
+    template<typename T, size_t N>
+    class spsc_ring {
+        static_assert(N >= 2 && (N & (N - 1)) == 0, "The capacity of a ring must be a power of two.");
+        static_assert(std::is_default_constructible_v<T> && std::is_move_assignable_v<T>, "T must be default constructible and move assignable.");
+
+        static constexpr size_t mask = N - 1;
+
+        //consumer side
+        alignas(cache_line_size) std::atomic<size_t> _head = 0;
+        size_t _cached_tail = 0;
+        size_t _peeked = 0;
+
+        //producer side
+        alignas(cache_line_size) std::atomic<size_t> _tail = 0;
+        size_t _cached_head = 0;
+        size_t _claimed = 0;
+
+        alignas(cache_line_size) std::array<T, N> _data {};
+
+        [[nodiscard]] size_t free_slots(const size_t tail) {
+            if (tail - _cached_head == N) {
+                _cached_head = _head.load(std::memory_order_acquire);
+            }
+            return N - (tail - _cached_head);
+        }
+
+        [[nodiscard]] size_t used_slots(const size_t head) {
+            if (head == _cached_tail) {
+                _cached_tail = _tail.load(std::memory_order_acquire);
+            }
+            return _cached_tail - head;
+        }
+
+    public:
+        spsc_ring() = default;
+
+        /* Threads refer to the ring, so it can't be copied or moved */
+        spsc_ring(const spsc_ring &other) = delete;
+        spsc_ring(spsc_ring &&other) noexcept = delete;
+        spsc_ring & operator=(const spsc_ring &other) = delete;
+        spsc_ring & operator=(spsc_ring &&other) noexcept = delete;
+
+        [[nodiscard]] static constexpr size_t capacity() { return N; }
+
+        /**
+         * Producer only. Adds a value to the ring.
+         * @return False if the ring is full.
+         */
+        bool push(const T &value) {
+            //a push moves the tail, so a region claimed before it no longer starts at the tail
+            _claimed = 0;
+            const auto tail = _tail.load(std::memory_order_relaxed);
+            if (free_slots(tail) == 0) {
+                return false;
+            }
+            _data[tail & mask] = value;
+            _tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * Producer only. Adds as many values as fit in the ring.
+         * @return The number of values that were added.
+         */
+        size_t push_n(const std::span<const T> values) {
+            _claimed = 0;
+            const auto tail = _tail.load(std::memory_order_relaxed);
+            const auto count = std::min(values.size(), free_slots(tail));
+
+            const auto start = tail & mask;
+            const auto first = std::min(count, N - start);
+            std::copy_n(values.begin(), first, _data.begin() + start);
+            std::copy_n(values.begin() + first, count - first, _data.begin());
+
+            _tail.store(tail + count, std::memory_order_release);
+            return count;
+        }
+
+        /**
+         * Producer only. Hands out a contiguous writable region of at most count elements. The region
+         * can be smaller than requested when the ring is almost full or wraps around.
+         * Nothing is visible to the consumer until commit() is called.
+         */
+        [[nodiscard]] std::span<T> claim(const size_t count) {
+            const auto tail = _tail.load(std::memory_order_relaxed);
+            const auto start = tail & mask;
+            _claimed = std::min({ count, free_slots(tail), N - start });
+            return std::span<T>(_data.data() + start, _claimed);
+        }
+
+        /**
+         * Producer only. Publishes the first count elements of the last claimed region. A push in between
+         * invalidates the claimed region, so committing after it only accepts a count of 0.
+         * @throws std::out_of_range if count is larger than the claimed region.
+         */
+        template<typename Policy = default_check>
+        void commit(const size_t count) {
+            if (!check<std::out_of_range, Policy>(count <= _claimed, "Commit is larger than the claimed region")) [[unlikely]] {
+                return;
+            }
+            _claimed = 0;
+            _tail.store(_tail.load(std::memory_order_relaxed) + count, std::memory_order_release);
+        }
+
+        /**
+         * Consumer only. Takes the oldest value out of the ring.
+         * @return The value, or nothing if the ring is empty.
+         */
+        [[nodiscard]] std::optional<T> pop() {
+            //a pop moves the head, so a region peeked before it no longer starts at the head
+            _peeked = 0;
+            const auto head = _head.load(std::memory_order_relaxed);
+            if (used_slots(head) == 0) {
+                return std::nullopt;
+            }
+            std::optional<T> value(std::move(_data[head & mask]));
+            _head.store(head + 1, std::memory_order_release);
+            return value;
+        }
+
+        /**
+         * Consumer only. Takes as many values out of the ring as fit in the output.
+         * @return The number of values that were taken.
+         */
+        size_t pop_n(const std::span<T> out) {
+            _peeked = 0;
+            const auto head = _head.load(std::memory_order_relaxed);
+            const auto count = std::min(out.size(), used_slots(head));
+
+            const auto start = head & mask;
+            const auto first = std::min(count, N - start);
+            std::move(_data.begin() + start, _data.begin() + start + first, out.begin());
+            std::move(_data.begin(), _data.begin() + (count - first), out.begin() + first);
+
+            _head.store(head + count, std::memory_order_release);
+            return count;
+        }
+
+        /**
+         * Consumer only. Hands out a contiguous readable region of at most count elements without
+         * taking them out of the ring. Call consume() to release them.
+         */
+        [[nodiscard]] std::span<const T> peek(const size_t count) {
+            const auto head = _head.load(std::memory_order_relaxed);
+            const auto start = head & mask;
+            _peeked = std::min({ count, used_slots(head), N - start });
+            return std::span<const T>(_data.data() + start, _peeked);
+        }
+
+        /**
+         * Consumer only. Releases the first count elements of the last peeked region. A pop in between
+         * invalidates the peeked region, so consuming after it only accepts a count of 0.
+         * @throws std::out_of_range if count is larger than the peeked region.
+         */
+        template<typename Policy = default_check>
+        void consume(const size_t count) {
+            if (!check<std::out_of_range, Policy>(count <= _peeked, "Consume is larger than the peeked region")) [[unlikely]] {
+                return;
+            }
+            _peeked = 0;
+            _head.store(_head.load(std::memory_order_relaxed) + count, std::memory_order_release);
+        }
+    };
+
+    /**
+     * A bounded, lock-free ring buffer for any number of producer and consumer threads. Every cell carries
+     * a sequence number, so producers and consumers only contend on their own counter and never on each
+     * other (based on Dmitry Vyukov's bounded MPMC queue).
+     *
+     * Claiming regions is not supported, because cells are owned by different threads at the same time.
+     * The batched push_n and pop_n are not atomic as a whole: values of other threads can be interleaved.
+     */
+    template<typename T, size_t N>
+    class mpmc_ring {
+        static_assert(N >= 2 && (N & (N - 1)) == 0, "The capacity of a ring must be a power of two.");
+        static_assert(std::is_default_constructible_v<T> && std::is_move_assignable_v<T>, "T must be default constructible and move assignable.");
+
+        static constexpr size_t mask = N - 1;
+
+        struct cell {
+            std::atomic<size_t> sequence;
+            T data {};
+        };
+
+        alignas(cache_line_size) std::atomic<size_t> _enqueue_position = 0;
+        alignas(cache_line_size) std::atomic<size_t> _dequeue_position = 0;
+        alignas(cache_line_size) std::array<cell, N> _cells;
+
+    public:
+        mpmc_ring() {
+            for (size_t i = 0; i < N; ++i) {
+                _cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        /* Threads refer to the ring, so it can't be copied or moved */
+        mpmc_ring(const mpmc_ring &other) = delete;
+        mpmc_ring(mpmc_ring &&other) noexcept = delete;
+        mpmc_ring & operator=(const mpmc_ring &other) = delete;
+        mpmc_ring & operator=(mpmc_ring &&other) noexcept = delete;
+
+        [[nodiscard]] static constexpr size_t capacity() { return N; }
+
+        /**
+         * Adds a value to the ring.
+         * @return False if the ring is full.
+         */
+        bool push(const T &value) {
+            auto position = _enqueue_position.load(std::memory_order_relaxed);
+            cell * target;
+            while (true) {
+                target = &_cells[position & mask];
+                const auto sequence = target->sequence.load(std::memory_order_acquire);
+                const auto difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+                if (difference == 0) {
+                    if (_enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+                } else if (difference < 0) {
+                    return false;
+                } else {
+                    position = _enqueue_position.load(std::memory_order_relaxed);
+                }
+            }
+
+            target->data = value;
+            target->sequence.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * Adds values until the ring is full.
+         * @return The number of values that were added.
+         */
+        size_t push_n(const std::span<const T> values) {
+            size_t count = 0;
+            while (count < values.size() && push(values[count])) {
+                ++count;
+            }
+            return count;
+        }
+
+        /**
+         * Takes the oldest value out of the ring.
+         * @return The value, or nothing if the ring is empty.
+         */
+        [[nodiscard]] std::optional<T> pop() {
+            auto position = _dequeue_position.load(std::memory_order_relaxed);
+            cell * source;
+            while (true) {
+                source = &_cells[position & mask];
+                const auto sequence = source->sequence.load(std::memory_order_acquire);
+                const auto difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+
+                if (difference == 0) {
+                    if (_dequeue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+                } else if (difference < 0) {
+                    return std::nullopt;
+                } else {
+                    position = _dequeue_position.load(std::memory_order_relaxed);
+                }
+            }
+
+            std::optional<T> value(std::move(source->data));
+            source->sequence.store(position + N, std::memory_order_release);
+            return value;
+        }
+
+        /**
+         * Takes values out of the ring until it is empty or the output is full.
+         * @return The number of values that were taken.
+         */
+        size_t pop_n(const std::span<T> out) {
+            size_t count = 0;
+            while (count < out.size()) {
+                auto value = pop();
+                if (!value.has_value()) break;
+                out[count++] = std::move(*value);
+            }
+            return count;
+        }
+    };
+
+    /**
+     * A bounded, lock-free ring buffer to move values between threads.
+     * @tparam T The type of the values.
+     * @tparam N The capacity, must be a power of two.
+     * @tparam Mode Whether the ring is used by a single producer and consumer or by many of them.
+     */
+    template<typename T, size_t N, ring_mode Mode = ring_mode::spsc>
+    using ring = std::conditional_t<Mode == ring_mode::spsc, spsc_ring<T, N>, mpmc_ring<T, N>>;
+}
+
+#endif //RING_HPP
@@ -15,6 +15,25 @@
 #include "returnof.hpp"
 #include "ptr.hpp"
 #include "index_ref.hpp"
+#include "arena.hpp"
+#include "pool.hpp"
+#include "slot_map.hpp"
+#include "layout.hpp"
+#include "mapped_memory.hpp"
+#include "cursor.hpp"
+#include "ring.hpp"
+#include "locks.hpp"
+#include "sync_owner.hpp"
+#include "result.hpp"
+#include "check.hpp"
+#include "telemetry.hpp"
+#include "parallel.hpp"
+#include "task_pool.hpp"
+#include "shared.hpp"
+#include "snapshot.hpp"
+#include "inline_memory.hpp"
+#include "allocation.hpp"
+#include "assert.hpp"
 
 
 #endif //SAFE_HPP
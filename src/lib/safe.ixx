@@ -35,8 +35,75 @@ export namespace safe {
     using safe::ref;
     using safe::ranged;
     using safe::ranged_clamped;
+    using safe::ranged_span;
+    using safe::validate_range;
+    using safe::clamp_range;
     using safe::return_of;
     using safe::ptr;
     using safe::ref_ptr;
     using safe::index_ref;
+    using safe::static_index_ref;
+    using safe::arena;
+    using safe::arena_fill;
+    using safe::arena_memory;
+    using safe::pool;
+    using safe::pool_ptr;
+    using safe::slot_map;
+    using safe::slot_handle;
+    using safe::field_name;
+    using safe::field;
+    using safe::layout;
+    using safe::layout_ref;
+    using safe::layout_mut;
+    using safe::mapped_memory;
+    using safe::map_access;
+    using safe::map_advice;
+    using safe::reader;
+    using safe::writer;
+    using safe::writer_region;
+    using safe::ring;
+    using safe::ring_mode;
+    using safe::spsc_ring;
+    using safe::mpmc_ring;
+    using safe::spinlock;
+    using safe::seqlock;
+    using safe::sync_owner;
+    using safe::sync_mut;
+    using safe::sync_ref;
+    using safe::result;
+    using safe::failure;
+    using safe::error_code;
+    using safe::niche_traits;
+    using safe::check_mode;
+    using safe::check_policy;
+    using safe::default_check;
+    using safe::trap_check;
+    using safe::abort_check;
+    using safe::throw_check;
+    using safe::log_check;
+    using safe::unsafe_unchecked;
+    using safe::check;
+    using safe::safe_assert;
+    using safe::check_site;
+    using safe::check_site_name;
+    using safe::telemetry_counters;
+    using safe::telemetry_snapshot;
+    using safe::parallel_options;
+    using safe::parallel_for_each;
+    using safe::parallel_for_each_chunk;
+    using safe::parallel_transform;
+    using safe::parallel_reduce;
+    using safe::task_pool;
+    using safe::task_scope;
+    using safe::sendable;
+    using safe::shared;
+    using safe::shared_mode;
+    using safe::snapshot;
+    using safe::snapshot_guard;
+    using safe::inline_memory;
+    using safe::memory_options;
+    using safe::page_backing;
+    using safe::page_size;
+    using safe::huge_page_size;
+    using safe::reserved_huge_page_size;
 }
\ No newline at end of file
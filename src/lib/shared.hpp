@@ -0,0 +1,195 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Laurens Ruijtenberg
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+#ifndef SHARED_HPP
+#define SHARED_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "cache_line.hpp"
+#include "check.hpp"
+#include "ref.hpp"
+
+namespace safe {
+
+    enum class shared_mode {
+        single_thread, //the count is a plain integer, the instances must stay on one thread
+        multi_thread   //the count is atomic and lives on its own cache line
+    };
+
+    namespace detail {
+        template<typename T, shared_mode Mode>
+        struct shared_block;
+
+        //the count sits right in front of the value, so for a small T a dereference and a count update touch the same line
+        template<typename T>
+        struct shared_block<T, shared_mode::single_thread> {
+            size_t count = 1;
+            T value;
+
+            template<typename... Args>
+            explicit shared_block(Args &&... args) : value(std::forward<Args>(args)...) {}
+
+            void retain() { ++count; }
+            [[nodiscard]] bool release() { return --count == 0; }
+            [[nodiscard]] size_t use_count() const { return count; }
+        };
+
+        //the count gets its own cache line, so copies on other threads don't invalidate the line readers of the value use
+        template<typename T>
+        struct shared_block<T, shared_mode::multi_thread> {
+            alignas(cache_line_size) std::atomic<size_t> count = 1;
+            alignas(cache_line_size) T value;
+
+            template<typename... Args>
+            explicit shared_block(Args &&... args) : value(std::forward<Args>(args)...) {}
+
+            void retain() { count.fetch_add(1, std::memory_order_relaxed); }
+
+            [[nodiscard]] bool release() {
+                if (count.fetch_sub(1, std::memory_order_release) == 1) {
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    return true;
+                }
+                return false;
+            }
+
+            [[nodiscard]] size_t use_count() const { return count.load(std::memory_order_relaxed); }
+        };
+    }
+
+    /**
+     * Shared ownership of an immutable value. The count and the value are allocated together, so unlike std::shared_ptr
+     * there is no separate control block to chase. The value can only be read: operator-> gives a const pointer and
+     * ref() hands out a safe::ref<T> borrow, neither of them touches the count.
+     * @tparam Mode single_thread for a plain count, multi_thread (the default) for an atomic count.
+     */
+    template<typename T, shared_mode Mode = shared_mode::multi_thread>
+    class shared {
+        using block = detail::shared_block<T, Mode>;
+
+        block * _block = nullptr;
+
+        explicit shared(block * b) : _block(b) {}
+
+        void release() {
+            if (_block != nullptr && _block->release()) {
+                delete _block;
+            }
+            _block = nullptr;
+        }
+
+        template<typename Policy = default_check>
+        [[nodiscard]] const T & checked_value() const {
+            if (!check<std::out_of_range, Policy>(_block != nullptr, "Shared value was moved from", check_site::shared_value)) [[unlikely]] {
+                //a zeroed value is only a safe fallback for trivially copyable types, anything else has none
+                if constexpr (std::is_trivially_copyable_v<T>) {
+                    return *detail::check_fallback<T>();
+                } else {
+                    detail::check_abort("Shared value was moved from");
+                }
+            }
+            return _block->value;
+        }
+
+    public:
+        /**
+         * Creates the value in place together with its count.
+         * @param args The arguments which are forwarded to the constructor of T.
+         */
+        template<typename... Args>
+        [[nodiscard]] static shared create(Args &&... args) {
+            return shared(new block(std::forward<Args>(args)...));
+        }
+
+        shared(const shared & other) noexcept : _block(other._block) {
+            if (_block != nullptr) _block->retain();
+        }
+
+        shared & operator=(const shared & other) noexcept {
+            if (this != &other) {
+                if (other._block != nullptr) other._block->retain();
+                release();
+                _block = other._block;
+            }
+            return *this;
+        }
+
+        shared(shared && other) noexcept : _block(std::exchange(other._block, nullptr)) {}
+
+        shared & operator=(shared && other) noexcept {
+            if (this != &other) {
+                release();
+                _block = std::exchange(other._block, nullptr);
+            }
+            return *this;
+        }
+
+        ~shared() {
+            release();
+        }
+
+        /**
+         * @return A read-only pointer to the value.
+         * @throws std::out_of_range if this instance was moved from.
+         */
+        [[nodiscard]] const T * operator->() const {
+            return &checked_value();
+        }
+
+        /**
+         * Borrows the value without touching the count. The borrow must not outlive this instance.
+         * @throws std::out_of_range if this instance was moved from.
+         */
+        [[nodiscard]] safe::ref<T> ref() const {
+            return safe::ref<T>::create_from(checked_value());
+        }
+
+        /**
+         * @return A copy of the value.
+         * @throws std::out_of_range if this instance was moved from.
+         */
+        [[nodiscard]] T clone() const {
+            return checked_value();
+        }
+
+        [[nodiscard]] bool is_valid() const {
+            return _block != nullptr;
+        }
+
+        /**
+         * @return The number of shared instances which own the value, 0 when this instance was moved from.
+         */
+        [[nodiscard]] size_t use_count() const {
+            return _block != nullptr ? _block->use_count() : 0;
+        }
+    };
+}
+
+#endif //SHARED_HPP
@@ -0,0 +1,636 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Laurens Ruijtenberg
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+#ifndef SIMD_HPP
+#define SIMD_HPP
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #define SAFE_SIMD_X86 1
+    #include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #define SAFE_SIMD_NEON 1
+    #include <arm_neon.h>
+    #if defined(__ARM_FEATURE_CRC32)
+        #include <arm_acle.h>
+    #endif
+#endif
+
+/*
+ * Internal SIMD kernels which are used by the bulk operations of the safe types. The kernels never do any
+ * bounds checking themselves, the caller validates the whole range up front. Every kernel has a scalar
+ * fallback, the vectorized variants are selected at runtime based on what the CPU supports.
+ */
+namespace safe::detail::simd {
+
+    [[nodiscard]] inline bool has_avx2() {
+#ifdef SAFE_SIMD_X86
+        static const bool supported = __builtin_cpu_supports("avx2");
+        return supported;
+#else
+        return false;
+#endif
+    }
+
+    [[nodiscard]] inline bool has_sse42() {
+#ifdef SAFE_SIMD_X86
+        static const bool supported = __builtin_cpu_supports("sse4.2");
+        return supported;
+#else
+        return false;
+#endif
+    }
+
+    [[nodiscard]] inline bool has_avx512() {
+#ifdef SAFE_SIMD_X86
+        static const bool supported = __builtin_cpu_supports("avx512f");
+        return supported;
+#else
+        return false;
+#endif
+    }
+
+    /* Copies sizeof(T) bytes from every base + offset into out */
+    template<typename T>
+    inline void gather_scalar(const std::byte * base, std::span<const size_t> offsets, T * out) {
+        for (size_t i = 0; i < offsets.size(); ++i) {
+            std::memcpy(&out[i], base + offsets[i], sizeof(T));
+        }
+    }
+
+    /* Copies every value to base + offset */
+    template<typename T>
+    inline void scatter_scalar(std::byte * base, std::span<const size_t> offsets, const T * values) {
+        for (size_t i = 0; i < offsets.size(); ++i) {
+            std::memcpy(base + offsets[i], &values[i], sizeof(T));
+        }
+    }
+
+#ifdef SAFE_SIMD_X86
+    __attribute__((target("avx2")))
+    inline void gather_avx2_32(const std::byte * base, std::span<const size_t> offsets, std::byte * out) {
+        const auto * source = reinterpret_cast<const int *>(base);
+        size_t i = 0;
+        for (; i + 4 <= offsets.size(); i += 4) {
+            const __m256i index = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(offsets.data() + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i * 4), _mm256_i64gather_epi32(source, index, 1));
+        }
+        gather_scalar(base, offsets.subspan(i), reinterpret_cast<uint32_t *>(out + i * 4));
+    }
+
+    __attribute__((target("avx2")))
+    inline void gather_avx2_64(const std::byte * base, std::span<const size_t> offsets, std::byte * out) {
+        const auto * source = reinterpret_cast<const long long *>(base);
+        size_t i = 0;
+        for (; i + 4 <= offsets.size(); i += 4) {
+            const __m256i index = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(offsets.data() + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i * 8), _mm256_i64gather_epi64(source, index, 1));
+        }
+        gather_scalar(base, offsets.subspan(i), reinterpret_cast<uint64_t *>(out + i * 8));
+    }
+#endif
+
+    /**
+     * Loads sizeof(T) bytes at every offset. Uses AVX2 gathers for 4 and 8 byte types when available.
+     */
+    template<typename T>
+    inline void gather(const std::byte * base, std::span<const size_t> offsets, T * out) {
+#ifdef SAFE_SIMD_X86
+        if constexpr (sizeof(size_t) == 8 && (sizeof(T) == 4 || sizeof(T) == 8)) {
+            if (has_avx2()) {
+                if constexpr (sizeof(T) == 4) {
+                    gather_avx2_32(base, offsets, reinterpret_cast<std::byte *>(out));
+                } else {
+                    gather_avx2_64(base, offsets, reinterpret_cast<std::byte *>(out));
+                }
+                return;
+            }
+        }
+#endif
+        gather_scalar(base, offsets, out);
+    }
+
+    /**
+     * Stores every value at its offset. There is no scatter instruction before AVX-512 and it isn't
+     * faster than scalar stores on current cores, so this is always the scalar loop.
+     */
+    template<typename T>
+    inline void scatter(std::byte * base, std::span<const size_t> offsets, const T * values) {
+        scatter_scalar(base, offsets, values);
+    }
+
+    /**
+     * @return The largest value in the span, or 0 if the span is empty. Written as a plain loop so it is auto-vectorized.
+     */
+    [[nodiscard]] inline size_t max_of(std::span<const size_t> values) {
+        size_t result = 0;
+        for (const auto value : values) {
+            result = value > result ? value : result;
+        }
+        return result;
+    }
+
+    /*
+     * Range kernels. A value is in range when from <= value <= to, so a NaN is never in range and is clamped to from.
+     */
+    template<typename T>
+    [[nodiscard]] inline bool all_within_scalar(const T * data, const size_t count, const T from, const T to) {
+        bool within = true;
+        for (size_t i = 0; i < count; ++i) {
+            within &= (data[i] >= from) & (data[i] <= to);
+        }
+        return within;
+    }
+
+    template<typename T>
+    inline void clamp_scalar(T * data, const size_t count, const T from, const T to) {
+        for (size_t i = 0; i < count; ++i) {
+            const T value = data[i];
+            data[i] = !(value >= from) ? from : (value > to ? to : value);
+        }
+    }
+
+#ifdef SAFE_SIMD_X86
+    __attribute__((target("avx2")))
+    inline bool all_within_avx2(const int32_t * data, const size_t count, const int32_t from, const int32_t to) {
+        const __m256i low = _mm256_set1_epi32(from);
+        const __m256i high = _mm256_set1_epi32(to);
+        __m256i outside = _mm256_setzero_si256();
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+            outside = _mm256_or_si256(outside, _mm256_or_si256(_mm256_cmpgt_epi32(low, value), _mm256_cmpgt_epi32(value, high)));
+        }
+        return _mm256_testz_si256(outside, outside) && all_within_scalar(data + i, count - i, from, to);
+    }
+
+    __attribute__((target("avx2")))
+    inline bool all_within_avx2(const float * data, const size_t count, const float from, const float to) {
+        const __m256 low = _mm256_set1_ps(from);
+        const __m256 high = _mm256_set1_ps(to);
+        __m256 outside = _mm256_setzero_ps();
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const __m256 value = _mm256_loadu_ps(data + i);
+            outside = _mm256_or_ps(outside, _mm256_or_ps(_mm256_cmp_ps(value, low, _CMP_NGE_UQ), _mm256_cmp_ps(value, high, _CMP_NLE_UQ)));
+        }
+        return _mm256_movemask_ps(outside) == 0 && all_within_scalar(data + i, count - i, from, to);
+    }
+
+    __attribute__((target("avx2")))
+    inline bool all_within_avx2(const double * data, const size_t count, const double from, const double to) {
+        const __m256d low = _mm256_set1_pd(from);
+        const __m256d high = _mm256_set1_pd(to);
+        __m256d outside = _mm256_setzero_pd();
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const __m256d value = _mm256_loadu_pd(data + i);
+            outside = _mm256_or_pd(outside, _mm256_or_pd(_mm256_cmp_pd(value, low, _CMP_NGE_UQ), _mm256_cmp_pd(value, high, _CMP_NLE_UQ)));
+        }
+        return _mm256_movemask_pd(outside) == 0 && all_within_scalar(data + i, count - i, from, to);
+    }
+
+    __attribute__((target("avx2")))
+    inline void clamp_avx2(int32_t * data, const size_t count, const int32_t from, const int32_t to) {
+        const __m256i low = _mm256_set1_epi32(from);
+        const __m256i high = _mm256_set1_epi32(to);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(data + i), _mm256_min_epi32(_mm256_max_epi32(value, low), high));
+        }
+        clamp_scalar(data + i, count - i, from, to);
+    }
+
+    __attribute__((target("avx2")))
+    inline void clamp_avx2(float * data, const size_t count, const float from, const float to) {
+        const __m256 low = _mm256_set1_ps(from);
+        const __m256 high = _mm256_set1_ps(to);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            //max_ps returns its second operand when the first is NaN, so NaN ends up as from
+            _mm256_storeu_ps(data + i, _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(data + i), low), high));
+        }
+        clamp_scalar(data + i, count - i, from, to);
+    }
+
+    __attribute__((target("avx2")))
+    inline void clamp_avx2(double * data, const size_t count, const double from, const double to) {
+        const __m256d low = _mm256_set1_pd(from);
+        const __m256d high = _mm256_set1_pd(to);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            _mm256_storeu_pd(data + i, _mm256_min_pd(_mm256_max_pd(_mm256_loadu_pd(data + i), low), high));
+        }
+        clamp_scalar(data + i, count - i, from, to);
+    }
+
+    __attribute__((target("avx512f")))
+    inline bool all_within_avx512(const int32_t * data, const size_t count, const int32_t from, const int32_t to) {
+        const __m512i low = _mm512_set1_epi32(from);
+        const __m512i high = _mm512_set1_epi32(to);
+        __mmask16 outside = 0;
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            const __m512i value = _mm512_loadu_si512(data + i);
+            outside |= _mm512_cmplt_epi32_mask(value, low) | _mm512_cmpgt_epi32_mask(value, high);
+        }
+        return outside == 0 && all_within_scalar(data + i, count - i, from, to);
+    }
+
+    __attribute__((target("avx512f")))
+    inline bool all_within_avx512(const float * data, const size_t count, const float from, const float to) {
+        const __m512 low = _mm512_set1_ps(from);
+        const __m512 high = _mm512_set1_ps(to);
+        __mmask16 outside = 0;
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            const __m512 value = _mm512_loadu_ps(data + i);
+            outside |= _mm512_cmp_ps_mask(value, low, _CMP_NGE_UQ) | _mm512_cmp_ps_mask(value, high, _CMP_NLE_UQ);
+        }
+        return outside == 0 && all_within_scalar(data + i, count - i, from, to);
+    }
+
+    __attribute__((target("avx512f")))
+    inline void clamp_avx512(int32_t * data, const size_t count, const int32_t from, const int32_t to) {
+        const __m512i low = _mm512_set1_epi32(from);
+        const __m512i high = _mm512_set1_epi32(to);
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            _mm512_storeu_si512(data + i, _mm512_min_epi32(_mm512_max_epi32(_mm512_loadu_si512(data + i), low), high));
+        }
+        clamp_scalar(data + i, count - i, from, to);
+    }
+
+    __attribute__((target("avx512f")))
+    inline void clamp_avx512(float * data, const size_t count, const float from, const float to) {
+        const __m512 low = _mm512_set1_ps(from);
+        const __m512 high = _mm512_set1_ps(to);
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            _mm512_storeu_ps(data + i, _mm512_min_ps(_mm512_max_ps(_mm512_loadu_ps(data + i), low), high));
+        }
+        clamp_scalar(data + i, count - i, from, to);
+    }
+#endif
+
+#ifdef SAFE_SIMD_NEON
+    inline bool all_within_neon(const int32_t * data, const size_t count, const int32_t from, const int32_t to) {
+        const int32x4_t low = vdupq_n_s32(from);
+        const int32x4_t high = vdupq_n_s32(to);
+        uint32x4_t outside = vdupq_n_u32(0);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const int32x4_t value = vld1q_s32(data + i);
+            outside = vorrq_u32(outside, vorrq_u32(vcltq_s32(value, low), vcgtq_s32(value, high)));
+        }
+        return vmaxvq_u32(outside) == 0 && all_within_scalar(data + i, count - i, from, to);
+    }
+
+    inline bool all_within_neon(const float * data, const size_t count, const float from, const float to) {
+        const float32x4_t low = vdupq_n_f32(from);
+        const float32x4_t high = vdupq_n_f32(to);
+        uint32x4_t within = vdupq_n_u32(0xffffffff);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const float32x4_t value = vld1q_f32(data + i);
+            within = vandq_u32(within, vandq_u32(vcgeq_f32(value, low), vcleq_f32(value, high)));
+        }
+        return vminvq_u32(within) == 0xffffffff && all_within_scalar(data + i, count - i, from, to);
+    }
+
+    inline void clamp_neon(int32_t * data, const size_t count, const int32_t from, const int32_t to) {
+        const int32x4_t low = vdupq_n_s32(from);
+        const int32x4_t high = vdupq_n_s32(to);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            vst1q_s32(data + i, vminq_s32(vmaxq_s32(vld1q_s32(data + i), low), high));
+        }
+        clamp_scalar(data + i, count - i, from, to);
+    }
+
+    inline void clamp_neon(float * data, const size_t count, const float from, const float to) {
+        const float32x4_t low = vdupq_n_f32(from);
+        const float32x4_t high = vdupq_n_f32(to);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            //the nm variants return the number when one operand is NaN, so NaN ends up as from
+            vst1q_f32(data + i, vminnmq_f32(vmaxnmq_f32(vld1q_f32(data + i), low), high));
+        }
+        clamp_scalar(data + i, count - i, from, to);
+    }
+#endif
+
+    /**
+     * @return True if every value is within [from, to].
+     */
+    template<typename T>
+    [[nodiscard]] inline bool all_within(const T * data, const size_t count, const T from, const T to) {
+#ifdef SAFE_SIMD_X86
+        if constexpr (std::is_same_v<T, int32_t> || std::is_same_v<T, float>) {
+            if (has_avx512()) return all_within_avx512(data, count, from, to);
+        }
+        if constexpr (std::is_same_v<T, int32_t> || std::is_same_v<T, float> || std::is_same_v<T, double>) {
+            if (has_avx2()) return all_within_avx2(data, count, from, to);
+        }
+#elif defined(SAFE_SIMD_NEON)
+        if constexpr (std::is_same_v<T, int32_t> || std::is_same_v<T, float>) {
+            return all_within_neon(data, count, from, to);
+        }
+#endif
+        return all_within_scalar(data, count, from, to);
+    }
+
+    /**
+     * Clamps every value to [from, to] in place.
+     */
+    template<typename T>
+    inline void clamp(T * data, const size_t count, const T from, const T to) {
+#ifdef SAFE_SIMD_X86
+        if constexpr (std::is_same_v<T, int32_t> || std::is_same_v<T, float>) {
+            if (has_avx512()) return clamp_avx512(data, count, from, to);
+        }
+        if constexpr (std::is_same_v<T, int32_t> || std::is_same_v<T, float> || std::is_same_v<T, double>) {
+            if (has_avx2()) return clamp_avx2(data, count, from, to);
+        }
+#elif defined(SAFE_SIMD_NEON)
+        if constexpr (std::is_same_v<T, int32_t> || std::is_same_v<T, float>) {
+            return clamp_neon(data, count, from, to);
+        }
+#endif
+        clamp_scalar(data, count, from, to);
+    }
+
+    /* Repeats value count times, the destination doesn't have to be aligned */
+    template<typename T>
+    inline void fill_scalar(std::byte * data, const size_t count, const T & value) {
+        for (size_t i = 0; i < count; ++i) {
+            std::memcpy(data + i * sizeof(T), &value, sizeof(T));
+        }
+    }
+
+    /* Compares the bytes instead of using operator==, so PODs without one work and the result matches the vector compare */
+    template<typename T>
+    [[nodiscard]] inline size_t find_scalar(const std::byte * data, const size_t count, const T & value) {
+        for (size_t i = 0; i < count; ++i) {
+            if (std::memcmp(data + i * sizeof(T), &value, sizeof(T)) == 0) {
+                return i;
+            }
+        }
+        return count;
+    }
+
+#ifdef SAFE_SIMD_X86
+    /* Writes a 32 byte pattern over and over, the tail is copied from the start of the pattern */
+    __attribute__((target("avx2")))
+    inline void fill_avx2(std::byte * data, const size_t length, const std::byte * pattern) {
+        const __m256i vector = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pattern));
+        size_t i = 0;
+        for (; i + 32 <= length; i += 32) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(data + i), vector);
+        }
+        std::memcpy(data + i, pattern, length - i);
+    }
+
+    template<typename T>
+    __attribute__((target("avx2")))
+    inline size_t find_avx2(const std::byte * data, const size_t count, const T value) {
+        __m256i needle;
+        if constexpr (sizeof(T) == 2) needle = _mm256_set1_epi16(std::bit_cast<int16_t>(value));
+        else if constexpr (sizeof(T) == 4) needle = _mm256_set1_epi32(std::bit_cast<int32_t>(value));
+        else needle = _mm256_set1_epi64x(std::bit_cast<int64_t>(value));
+
+        constexpr size_t lanes = 32 / sizeof(T);
+        size_t i = 0;
+        for (; i + lanes <= count; i += lanes) {
+            const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i * sizeof(T)));
+            __m256i equal;
+            if constexpr (sizeof(T) == 2) equal = _mm256_cmpeq_epi16(values, needle);
+            else if constexpr (sizeof(T) == 4) equal = _mm256_cmpeq_epi32(values, needle);
+            else equal = _mm256_cmpeq_epi64(values, needle);
+
+            //every equal lane sets sizeof(T) bits in the byte mask, the lowest one gives the first match
+            const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(equal));
+            if (mask != 0) {
+                return i + std::countr_zero(mask) / sizeof(T);
+            }
+        }
+        return i + find_scalar(data + i * sizeof(T), count - i, value);
+    }
+#endif
+
+    /**
+     * Repeats value count times from data onwards. Uses a 32 byte AVX2 pattern store when T divides it, memset for single bytes.
+     */
+    template<typename T>
+    inline void fill(std::byte * data, const size_t count, const T & value) {
+        if constexpr (sizeof(T) == 1) {
+            std::memset(data, std::bit_cast<unsigned char>(value), count);
+            return;
+        } else {
+#ifdef SAFE_SIMD_X86
+            if constexpr (32 % sizeof(T) == 0) {
+                if (has_avx2()) {
+                    std::array<std::byte, 32> pattern;
+                    fill_scalar(pattern.data(), 32 / sizeof(T), value);
+                    return fill_avx2(data, count * sizeof(T), pattern.data());
+                }
+            }
+#endif
+            fill_scalar(data, count, value);
+        }
+    }
+
+    /**
+     * @return The index of the first of count values which is bitwise equal to value, or count when there is none.
+     * Single bytes go through memchr, which the C library already vectorizes. 2, 4 and 8 byte values use AVX2 compares.
+     */
+    template<typename T>
+    [[nodiscard]] inline size_t find(const std::byte * data, const size_t count, const T & value) {
+        if constexpr (sizeof(T) == 1) {
+            const auto * found = static_cast<const std::byte *>(std::memchr(data, std::bit_cast<unsigned char>(value), count));
+            return found != nullptr ? static_cast<size_t>(found - data) : count;
+        } else {
+#ifdef SAFE_SIMD_X86
+            if constexpr (sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8) {
+                if (has_avx2()) return find_avx2(data, count, value);
+            }
+#endif
+            return find_scalar(data, count, value);
+        }
+    }
+
+    /* The reflected CRC32C (Castagnoli) table, one byte at a time */
+    inline constexpr auto crc32c_table = [] {
+        std::array<uint32_t, 256> table {};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = (crc >> 1) ^ (0x82F63B78u & (0u - (crc & 1u)));
+            }
+            table[i] = crc;
+        }
+        return table;
+    }();
+
+    [[nodiscard]] inline uint32_t crc32c_scalar(uint32_t crc, const std::byte * data, const size_t length) {
+        for (size_t i = 0; i < length; ++i) {
+            crc = crc32c_table[(crc ^ static_cast<uint8_t>(data[i])) & 0xff] ^ (crc >> 8);
+        }
+        return crc;
+    }
+
+#ifdef SAFE_SIMD_X86
+    __attribute__((target("sse4.2")))
+    inline uint32_t crc32c_sse42(uint32_t crc, const std::byte * data, const size_t length) {
+        size_t i = 0;
+#if defined(__x86_64__)
+        uint64_t crc64 = crc;
+        for (; i + 8 <= length; i += 8) {
+            uint64_t value;
+            std::memcpy(&value, data + i, sizeof(value));
+            crc64 = _mm_crc32_u64(crc64, value);
+        }
+        crc = static_cast<uint32_t>(crc64);
+#endif
+        for (; i < length; ++i) {
+            crc = _mm_crc32_u8(crc, static_cast<uint8_t>(data[i]));
+        }
+        return crc;
+    }
+#endif
+
+#if defined(SAFE_SIMD_NEON) && defined(__ARM_FEATURE_CRC32)
+    inline uint32_t crc32c_arm(uint32_t crc, const std::byte * data, const size_t length) {
+        size_t i = 0;
+        for (; i + 8 <= length; i += 8) {
+            uint64_t value;
+            std::memcpy(&value, data + i, sizeof(value));
+            crc = __crc32cd(crc, value);
+        }
+        for (; i < length; ++i) {
+            crc = __crc32cb(crc, static_cast<uint8_t>(data[i]));
+        }
+        return crc;
+    }
+#endif
+
+    /**
+     * @param crc The checksum of the preceding bytes, to compute a checksum in parts. 0 for the first part.
+     * @return The CRC32C (Castagnoli) checksum, using the SSE4.2 or ARMv8 CRC instructions when available.
+     */
+    [[nodiscard]] inline uint32_t crc32c(const uint32_t crc, const std::byte * data, const size_t length) {
+#ifdef SAFE_SIMD_X86
+        if (has_sse42()) return ~crc32c_sse42(~crc, data, length);
+#elif defined(SAFE_SIMD_NEON) && defined(__ARM_FEATURE_CRC32)
+        return ~crc32c_arm(~crc, data, length);
+#endif
+        return ~crc32c_scalar(~crc, data, length);
+    }
+
+    template<typename T>
+    [[nodiscard]] inline T read_little_endian(const std::byte * data) {
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+        if constexpr (std::endian::native == std::endian::big) {
+            value = std::byteswap(value);
+        }
+        return value;
+    }
+
+    /**
+     * @return The XXH64 hash of the bytes. XXH64 gets its speed from four independent multiply lanes, which the
+     * out-of-order core already runs in parallel, so there is no vector kernel for it.
+     */
+    [[nodiscard]] inline uint64_t xxhash64(const std::byte * data, const size_t length, const uint64_t seed) {
+        constexpr uint64_t prime1 = 0x9E3779B185EBCA87ull;
+        constexpr uint64_t prime2 = 0xC2B2AE3D27D4EB4Full;
+        constexpr uint64_t prime3 = 0x165667B19E3779F9ull;
+        constexpr uint64_t prime4 = 0x85EBCA77C2B2AE63ull;
+        constexpr uint64_t prime5 = 0x27D4EB2F165667C5ull;
+
+        const auto round = [](uint64_t accumulator, const uint64_t input) {
+            accumulator += input * prime2;
+            return std::rotl(accumulator, 31) * prime1;
+        };
+        const auto merge = [&round](uint64_t hash, const uint64_t accumulator) {
+            hash ^= round(0, accumulator);
+            return hash * prime1 + prime4;
+        };
+
+        size_t i = 0;
+        uint64_t hash;
+        if (length >= 32) {
+            uint64_t v1 = seed + prime1 + prime2;
+            uint64_t v2 = seed + prime2;
+            uint64_t v3 = seed;
+            uint64_t v4 = seed - prime1;
+            for (; i + 32 <= length; i += 32) {
+                v1 = round(v1, read_little_endian<uint64_t>(data + i));
+                v2 = round(v2, read_little_endian<uint64_t>(data + i + 8));
+                v3 = round(v3, read_little_endian<uint64_t>(data + i + 16));
+                v4 = round(v4, read_little_endian<uint64_t>(data + i + 24));
+            }
+            hash = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) + std::rotl(v4, 18);
+            hash = merge(hash, v1);
+            hash = merge(hash, v2);
+            hash = merge(hash, v3);
+            hash = merge(hash, v4);
+        } else {
+            hash = seed + prime5;
+        }
+
+        hash += length;
+        for (; i + 8 <= length; i += 8) {
+            hash ^= round(0, read_little_endian<uint64_t>(data + i));
+            hash = std::rotl(hash, 27) * prime1 + prime4;
+        }
+        if (i + 4 <= length) {
+            hash ^= static_cast<uint64_t>(read_little_endian<uint32_t>(data + i)) * prime1;
+            hash = std::rotl(hash, 23) * prime2 + prime3;
+            i += 4;
+        }
+        for (; i < length; ++i) {
+            hash ^= static_cast<uint8_t>(data[i]) * prime5;
+            hash = std::rotl(hash, 11) * prime1;
+        }
+
+        hash ^= hash >> 33;
+        hash *= prime2;
+        hash ^= hash >> 29;
+        hash *= prime3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+}
+
+#endif //SIMD_HPP
@@ -0,0 +1,217 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Laurens Ruijtenberg
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+#ifndef SLOT_MAP_HPP
+#define SLOT_MAP_HPP
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "check.hpp"
+#include "ptr.hpp"
+
+namespace safe {
+
+    template<typename T>
+    class slot_map;
+
+    /**
+     * A handle to an element in a safe::slot_map. It consists of a slot index and the generation
+     * of that slot at the moment the element was inserted. Erasing the element bumps the generation,
+     * so an old handle can never alias an element that was inserted later. Unlike index_ref, the handle
+     * also stays valid when the slot map reorders or reallocates its storage.
+     */
+    template<typename T>
+    class slot_handle {
+        friend class slot_map<T>;
+
+        static constexpr uint32_t no_slot = std::numeric_limits<uint32_t>::max();
+
+        uint32_t _index = no_slot;
+        uint32_t _generation = 0;
+
+        constexpr slot_handle(const uint32_t index, const uint32_t generation) : _index(index), _generation(generation) {}
+    public:
+        /* An empty handle, it is never valid in any slot map */
+        constexpr slot_handle() = default;
+
+        constexpr slot_handle(const slot_handle<T> &other) = default;
+        constexpr slot_handle<T> & operator=(const slot_handle<T> &other) = default;
+
+        [[nodiscard]] constexpr bool operator==(const slot_handle<T> &other) const = default;
+    };
+
+    /**
+     * A container which keeps its elements in one dense, contiguous array and hands out generation-checked
+     * slot_handles to them. Lookups through a handle, inserts and erases are all O(1). Erasing swaps the
+     * last element into the gap, so iterating over the slot map always walks over a packed array.
+     *
+     * @note The order of the elements is not stable, erasing changes the position of the last element.
+     */
+    template<typename T>
+    class slot_map {
+        struct slot {
+            uint32_t dense_index;
+            uint32_t generation;
+        };
+
+        static constexpr uint32_t no_slot = slot_handle<T>::no_slot;
+
+        std::vector<T> _data;
+        std::vector<uint32_t> _data_to_slot;
+        std::vector<slot> _slots;
+        uint32_t _free_head = no_slot;
+
+        [[nodiscard]] constexpr bool is_live(const slot_handle<T> &handle) const {
+            return handle._index < _slots.size()
+                && _slots[handle._index].generation == handle._generation;
+        }
+
+    public:
+        using value_type = T;
+        using iterator = typename std::vector<T>::iterator;
+        using const_iterator = typename std::vector<T>::const_iterator;
+
+        slot_map() = default;
+
+        /**
+         * Reserves storage for the given number of elements.
+         */
+        void reserve(const size_t count) {
+            _data.reserve(count);
+            _data_to_slot.reserve(count);
+            _slots.reserve(count);
+        }
+
+        /**
+         * Inserts a new element which is constructed from the given arguments.
+         * @throws std::length_error if the slot map already holds 2^32 - 1 elements.
+         * @return A handle to the new element, or an empty handle when the slot map is full and the check policy continues.
+         */
+        template<typename Policy = default_check, typename... Args>
+        slot_handle<T> emplace(Args&&... args) {
+            uint32_t index;
+            if (_free_head != no_slot) {
+                index = _free_head;
+                _free_head = _slots[index].dense_index;
+            } else {
+                if (!check_always<std::length_error, Policy>(_slots.size() < no_slot, "Slot map is full")) [[unlikely]] {
+                    return slot_handle<T>();
+                }
+                index = static_cast<uint32_t>(_slots.size());
+                _slots.push_back(slot { no_slot, 0 });
+            }
+
+            _data.emplace_back(std::forward<Args>(args)...);
+            _data_to_slot.push_back(index);
+            _slots[index].dense_index = static_cast<uint32_t>(_data.size() - 1);
+
+            return slot_handle<T>(index, _slots[index].generation);
+        }
+
+        slot_handle<T> insert(const T &value) {
+            return emplace(value);
+        }
+
+        slot_handle<T> insert(T &&value) {
+            return emplace(std::move(value));
+        }
+
+        /**
+         * Removes the element the handle refers to by swapping the last element into its place.
+         * All copies of the handle become invalid.
+         * @return False if the handle was already invalid.
+         */
+        bool erase(const slot_handle<T> &handle) {
+            if (!is_live(handle)) {
+                return false;
+            }
+
+            auto & erased = _slots[handle._index];
+            const auto dense_index = erased.dense_index;
+            const auto last_index = static_cast<uint32_t>(_data.size() - 1);
+
+            if (dense_index != last_index) {
+                _data[dense_index] = std::move(_data[last_index]);
+                _data_to_slot[dense_index] = _data_to_slot[last_index];
+                _slots[_data_to_slot[dense_index]].dense_index = dense_index;
+            }
+
+            _data.pop_back();
+            _data_to_slot.pop_back();
+
+            //the dense index of a free slot is reused as the link in the free list
+            ++erased.generation;
+            erased.dense_index = _free_head;
+            _free_head = handle._index;
+
+            return true;
+        }
+
+        /**
+         * @return True if the handle refers to an element in this slot map.
+         */
+        [[nodiscard]] constexpr bool contains(const slot_handle<T> &handle) const {
+            return is_live(handle);
+        }
+
+        /**
+         * @return A copy of the element the handle refers to.
+         * @throws std::out_of_range if the handle is no longer valid.
+         */
+        template<typename Policy = default_check>
+        [[nodiscard]] T value(const slot_handle<T> &handle) const {
+            if (!check<std::out_of_range, Policy>(is_live(handle), "Invalid slot handle")) [[unlikely]] {
+                return detail::check_fallback_value<T>("Invalid slot handle");
+            }
+            return _data[_slots[handle._index].dense_index];
+        }
+
+        /**
+         * @return A ref_ptr to the element the handle refers to, or an empty ref_ptr if the handle is no longer valid.
+         * @note The ref_ptr is only valid until the next insert or erase.
+         */
+        [[nodiscard]] ref_ptr<T> get(const slot_handle<T> &handle) {
+            if (!is_live(handle)) {
+                return ref_ptr<T>::create_empty();
+            }
+            return ref_ptr<T>::create_from(&_data[_slots[handle._index].dense_index]);
+        }
+
+        [[nodiscard]] constexpr size_t size() const { return _data.size(); }
+        [[nodiscard]] constexpr bool empty() const { return _data.empty(); }
+
+        /* Iteration walks over the dense array of elements */
+        [[nodiscard]] iterator begin() { return _data.begin(); }
+        [[nodiscard]] iterator end() { return _data.end(); }
+        [[nodiscard]] const_iterator begin() const { return _data.begin(); }
+        [[nodiscard]] const_iterator end() const { return _data.end(); }
+    };
+}
+
+#endif //SLOT_MAP_HPP
@@ -0,0 +1,351 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Laurens Ruijtenberg
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#elif defined(__linux__)
+    #include <linux/membarrier.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+#include "cache_line.hpp"
+#include "ref.hpp"
+
+namespace safe {
+
+    namespace detail {
+        /*
+         * The writer side of an asymmetric fence. It acts as a full fence on every running thread of the process, so
+         * readers get away with a compiler barrier where they would otherwise need a full fence of their own. It costs
+         * the writer an inter-processor interrupt per CPU that runs one of our threads, microseconds instead of nanoseconds.
+         */
+        inline bool register_heavy_fence() {
+#if defined(_WIN32)
+            return true;
+#elif defined(__linux__) && defined(SYS_membarrier)
+            //expedited membarrier needs a registration per process, it fails on kernels older than 4.14
+            return syscall(SYS_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0, 0) == 0;
+#else
+            return false;
+#endif
+        }
+
+        inline void heavy_fence() {
+#if defined(_WIN32)
+            FlushProcessWriteBuffers();
+#elif defined(__linux__) && defined(SYS_membarrier)
+            syscall(SYS_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0, 0);
+#endif
+        }
+
+        /*
+         * Epoch based reclamation shared by all snapshots. Every reading thread owns a slot on its own cache line in
+         * which it announces the epoch it started reading in. A retired value is freed once every slot is either idle
+         * or announces a later epoch than the one the value was retired in.
+         */
+        class epoch_domain {
+        public:
+            struct alignas(cache_line_size) slot {
+                std::atomic<uint64_t> epoch = 0; //0 means the thread isn't reading
+                size_t depth = 0;                //only touched by the owning thread, for nested reads
+                bool in_use = false;             //guarded by the domain mutex
+            };
+
+        private:
+            struct retired {
+                void * pointer;
+                void (*destroy)(void *);
+                uint64_t epoch;
+            };
+
+            alignas(cache_line_size) std::atomic<uint64_t> _epoch = 1;
+            const bool _asymmetric = register_heavy_fence();
+            std::mutex _mutex;
+            std::vector<std::unique_ptr<slot>> _slots;
+            std::vector<retired> _retired;
+
+            struct thread_slot {
+                slot * current = nullptr;
+
+                ~thread_slot() {
+                    if (current != nullptr) {
+                        instance().release(current);
+                    }
+                }
+            };
+
+            slot * acquire() {
+                std::lock_guard lock(_mutex);
+                for (const auto & candidate : _slots) {
+                    if (!candidate->in_use) {
+                        candidate->in_use = true;
+                        return candidate.get();
+                    }
+                }
+                _slots.push_back(std::make_unique<slot>());
+                _slots.back()->in_use = true;
+                return _slots.back().get();
+            }
+
+            void release(slot * s) {
+                std::lock_guard lock(_mutex);
+                s->epoch.store(0, std::memory_order_release);
+                s->in_use = false;
+            }
+
+            //expects the mutex to be held, moves the nodes no reader can hold anymore out of the list so they can be
+            //destroyed after unlocking: a destructor can take long, or retire a snapshot of its own
+            [[nodiscard]] std::vector<retired> take_reclaimable_locked() {
+                //pairs with the fence in enter(): a reader's epoch is either visible here, or its load of the current
+                //version comes after this fence and already sees the new one
+                if (_asymmetric) {
+                    heavy_fence();
+                } else {
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                }
+                uint64_t oldest = UINT64_MAX;
+                for (const auto & s : _slots) {
+                    const uint64_t epoch = s->epoch.load(std::memory_order_relaxed);
+                    if (epoch != 0 && epoch < oldest) oldest = epoch;
+                }
+                const auto reclaimable = std::partition(_retired.begin(), _retired.end(), [&](const retired & r) {
+                    return r.epoch >= oldest;
+                });
+                std::vector<retired> result(reclaimable, _retired.end());
+                _retired.erase(reclaimable, _retired.end());
+                return result;
+            }
+
+            static void destroy_all(const std::vector<retired> & nodes) {
+                for (const auto & r : nodes) {
+                    r.destroy(r.pointer);
+                }
+            }
+
+        public:
+            static epoch_domain & instance() {
+                static epoch_domain domain;
+                return domain;
+            }
+
+            ~epoch_domain() {
+                destroy_all(_retired);
+            }
+
+            static slot & local_slot() {
+                thread_local thread_slot local;
+                if (local.current == nullptr) [[unlikely]] {
+                    local.current = instance().acquire();
+                }
+                return *local.current;
+            }
+
+            //the epoch has to be visible before the reader loads the version, a seq_cst store would be a locked xchg on x86,
+            //so the reader only stops the compiler from reordering and the writer's heavy fence does the rest
+            void enter(slot & s) {
+                if (s.depth++ == 0) {
+                    s.epoch.store(_epoch.load(std::memory_order_acquire), std::memory_order_relaxed);
+                    if (_asymmetric) [[likely]] {
+                        std::atomic_signal_fence(std::memory_order_seq_cst);
+                    } else {
+                        std::atomic_thread_fence(std::memory_order_seq_cst);
+                    }
+                }
+            }
+
+            static void leave(slot & s) {
+                if (--s.depth == 0) {
+                    s.epoch.store(0, std::memory_order_release);
+                }
+            }
+
+            /* Frees the pointer once no reader can hold it anymore, it must already be unreachable for new readers */
+            void retire(void * pointer, void (*destroy)(void *)) {
+                std::vector<retired> reclaimable;
+                {
+                    std::lock_guard lock(_mutex);
+                    const uint64_t epoch = _epoch.fetch_add(1, std::memory_order_seq_cst);
+                    _retired.push_back({ pointer, destroy, epoch });
+                    reclaimable = take_reclaimable_locked();
+                }
+                destroy_all(reclaimable);
+            }
+
+            void reclaim() {
+                std::vector<retired> reclaimable;
+                {
+                    std::lock_guard lock(_mutex);
+                    reclaimable = take_reclaimable_locked();
+                }
+                destroy_all(reclaimable);
+            }
+
+            [[nodiscard]] size_t pending() {
+                std::lock_guard lock(_mutex);
+                return _retired.size();
+            }
+        };
+    }
+
+    template<typename T>
+    class snapshot;
+
+    /**
+     * A read guard on the current version of a snapshot. The version stays alive as long as the guard exists, even
+     * when a newer version is published in the meantime. Like safe::ref it can't be copied or moved, so it can't
+     * outlive the scope it was created in.
+     */
+    template<typename T>
+    class snapshot_guard {
+        friend class snapshot<T>;
+
+        detail::epoch_domain::slot & _slot;
+        const T * _value;
+
+        snapshot_guard(detail::epoch_domain::slot & s, const std::atomic<const T *> & current) : _slot(s) {
+            detail::epoch_domain::instance().enter(_slot);
+            _value = current.load(std::memory_order_acquire);
+        }
+
+    public:
+        snapshot_guard(const snapshot_guard &) = delete;
+        snapshot_guard(snapshot_guard &&) = delete;
+        snapshot_guard & operator=(const snapshot_guard &) = delete;
+        snapshot_guard & operator=(snapshot_guard &&) = delete;
+
+        ~snapshot_guard() {
+            detail::epoch_domain::leave(_slot);
+        }
+
+        [[nodiscard]] const T * operator->() const {
+            return _value;
+        }
+
+        /**
+         * @return A borrow of the version, it must not outlive the guard.
+         */
+        [[nodiscard]] safe::ref<T> ref() const {
+            return safe::ref<T>::create_from(*_value);
+        }
+
+        [[nodiscard]] T clone() const {
+            return *_value;
+        }
+    };
+
+    /**
+     * Publishes versions of a read-mostly value, in the style of RCU. Readers take a snapshot_guard with read(),
+     * which costs a thread local lookup, two loads and a plain store to a cache line owned by the reading thread, and
+     * never waits for a writer. That relies on an asymmetric fence: every publish pays for membarrier() on Linux or
+     * FlushProcessWriteBuffers() on Windows instead. Where neither is available the reader needs a full fence after
+     * its store (mfence on x86, tens of cycles), which is still uncontended.
+     *
+     * Writers replace the whole value with publish(), the previous version is freed with epoch based reclamation
+     * once the last reader which could see it is done. Reclamation runs when a version is published, so a version
+     * which was still being read at that moment stays alive until the next publish() or an explicit reclaim(),
+     * readers leaving their guard never free anything.
+     *
+     * The snapshot itself must outlive all of its guards.
+     */
+    template<typename T>
+    class snapshot {
+        std::atomic<const T *> _current;
+        std::mutex _writer;
+
+        static void destroy(void * pointer) {
+            delete static_cast<const T *>(pointer);
+        }
+
+    public:
+        /**
+         * @param initial The first version.
+         */
+        explicit snapshot(T initial) : _current(new T(std::move(initial))) {}
+
+        snapshot(const snapshot &) = delete;
+        snapshot & operator=(const snapshot &) = delete;
+
+        ~snapshot() {
+            delete _current.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @return A guard on the version which is current at the moment of the call.
+         */
+        [[nodiscard]] snapshot_guard<T> read() const {
+            return snapshot_guard<T>(detail::epoch_domain::local_slot(), _current);
+        }
+
+        /**
+         * Makes value the current version. Readers which started before keep seeing the previous version.
+         * @param value The new version.
+         */
+        void publish(T value) {
+            const T * next = new T(std::move(value));
+            std::lock_guard lock(_writer);
+            const T * previous = _current.exchange(next, std::memory_order_seq_cst);
+            detail::epoch_domain::instance().retire(const_cast<T *>(previous), &destroy);
+        }
+
+        /**
+         * Builds the new version from a copy of the current one.
+         * @param update Called as update(T &) on the copy before it is published.
+         */
+        template<typename Fn>
+        void update(Fn && update) {
+            std::lock_guard lock(_writer);
+            auto next = std::make_unique<T>(*_current.load(std::memory_order_acquire));
+            std::forward<Fn>(update)(*next);
+            const T * previous = _current.exchange(next.release(), std::memory_order_seq_cst);
+            detail::epoch_domain::instance().retire(const_cast<T *>(previous), &destroy);
+        }
+
+        /**
+         * Frees the retired versions which no reader holds anymore, e.g. after a last publish() when no further
+         * versions are coming. Retired versions of all snapshots share one domain, so this frees theirs as well.
+         */
+        void reclaim() {
+            detail::epoch_domain::instance().reclaim();
+        }
+    };
+}
+
+#endif //SNAPSHOT_HPP
@@ -0,0 +1,325 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Laurens Ruijtenberg
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+#ifndef SYNC_OWNER_HPP
+#define SYNC_OWNER_HPP
+
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <shared_mutex>
+#include <type_traits>
+#include <utility>
+
+#include "locks.hpp"
+#include "mut.hpp"
+#include "ref.hpp"
+
+namespace safe {
+
+    template<typename L>
+    concept shared_lockable = requires(L lock) {
+        lock.lock_shared();
+        lock.unlock_shared();
+    };
+
+    template<typename T, typename Lock>
+    class sync_owner;
+
+    /**
+     * A guard which gives read and write access to the value of a safe::sync_owner. It holds the exclusive
+     * lock for as long as it lives. Like safe::mut it can't be copied or moved, so it can't outlive the scope
+     * in which it was requested.
+     */
+    template<typename T, typename Lock>
+    class sync_mut {
+        friend class sync_owner<T, Lock>;
+
+        std::unique_lock<Lock> _lock;
+        T & _data;
+
+        sync_mut(Lock & lock, T & data) : _lock(lock), _data(data) {}
+    public:
+        sync_mut(const sync_mut & other) = delete;
+        sync_mut(sync_mut && other) noexcept = delete;
+        sync_mut & operator=(const sync_mut & other) = delete;
+        sync_mut & operator=(sync_mut && other) noexcept = delete;
+
+        sync_mut & operator=(const T & value) {
+            _data = value;
+            return *this;
+        }
+
+        T * operator->() const {
+            return &_data;
+        }
+
+        /* The returned mut must not outlive the guard, which the non-copyable mut already enforces for arguments */
+        [[nodiscard]] operator safe::mut<T>() const {
+            return safe::mut<T>::create_from(_data);
+        }
+
+        [[nodiscard]] T value() const {
+            return _data;
+        }
+
+        [[nodiscard]] T clone() const {
+            return _data;
+        }
+    };
+
+    /**
+     * A guard which gives read-only access to the value of a safe::sync_owner. It holds a shared lock
+     * (or the exclusive lock, when the lock policy has no shared mode) for as long as it lives.
+     */
+    template<typename T, typename Lock>
+    class sync_ref {
+        friend class sync_owner<T, Lock>;
+
+        using lock_type = std::conditional_t<shared_lockable<Lock>, std::shared_lock<Lock>, std::unique_lock<Lock>>;
+
+        lock_type _lock;
+        const T & _data;
+
+        sync_ref(Lock & lock, const T & data) : _lock(lock), _data(data) {}
+    public:
+        sync_ref(const sync_ref & other) = delete;
+        sync_ref(sync_ref && other) noexcept = delete;
+        sync_ref & operator=(const sync_ref & other) = delete;
+        sync_ref & operator=(sync_ref && other) noexcept = delete;
+
+        const T * operator->() const {
+            return &_data;
+        }
+
+        [[nodiscard]] operator safe::ref<T>() const {
+            return safe::ref<T>::create_from(_data);
+        }
+
+        [[nodiscard]] T value() const {
+            return _data;
+        }
+
+        [[nodiscard]] T clone() const {
+            return _data;
+        }
+    };
+
+    /**
+     * An owner which can be shared between threads. The value can only be reached through guards:
+     * mut() returns a guard which holds the exclusive lock and ref() returns one which holds a shared lock.
+     * @tparam T The type of the value.
+     * @tparam Lock The lock policy, for example std::shared_mutex, std::mutex, safe::spinlock or safe::seqlock.
+     */
+    template<typename T, typename Lock = std::shared_mutex>
+    class sync_owner {
+        T _data;
+        mutable Lock _lock;
+    public:
+        sync_owner() : _data(T{}) {}
+
+        template<typename... Args>
+        explicit sync_owner(Args&&... args) : _data(std::forward<Args>(args)...) {}
+
+        /* Other threads refer to the owner, so it can't be copied or moved */
+        sync_owner(const sync_owner & other) = delete;
+        sync_owner(sync_owner && other) noexcept = delete;
+        sync_owner & operator=(const sync_owner & other) = delete;
+        sync_owner & operator=(sync_owner && other) noexcept = delete;
+
+        [[nodiscard]] sync_mut<T, Lock> mut() {
+            return sync_mut<T, Lock>(_lock, _data);
+        }
+
+        [[nodiscard]] sync_ref<T, Lock> ref() const {
+            return sync_ref<T, Lock>(_lock, _data);
+        }
+
+        /**
+         * @return A copy of the value, taken while holding a shared lock.
+         */
+        [[nodiscard]] T value() const {
+            return ref().value();
+        }
+    };
+
+    /**
+     * The write guard of a sync_owner with a seqlock. It works on a private copy of the value, which is
+     * published when the guard goes out of scope.
+     */
+    template<typename T>
+    class sync_mut<T, seqlock> {
+        friend class sync_owner<T, seqlock>;
+
+        sync_owner<T, seqlock> & _owner;
+        T _data;
+
+        explicit sync_mut(sync_owner<T, seqlock> & owner) : _owner(owner) {
+            _owner._lock.lock();
+            _data = _owner.load_unlocked();
+        }
+    public:
+        ~sync_mut() {
+            _owner.store_unlocked(_data);
+            _owner._lock.unlock();
+        }
+
+        sync_mut(const sync_mut & other) = delete;
+        sync_mut(sync_mut && other) noexcept = delete;
+        sync_mut & operator=(const sync_mut & other) = delete;
+        sync_mut & operator=(sync_mut && other) noexcept = delete;
+
+        sync_mut & operator=(const T & value) {
+            _data = value;
+            return *this;
+        }
+
+        T * operator->() {
+            return &_data;
+        }
+
+        [[nodiscard]] operator safe::mut<T>() {
+            return safe::mut<T>::create_from(_data);
+        }
+
+        [[nodiscard]] T value() const {
+            return _data;
+        }
+
+        [[nodiscard]] T clone() const {
+            return _data;
+        }
+    };
+
+    /**
+     * The read guard of a sync_owner with a seqlock. It holds a consistent snapshot of the value instead of a lock.
+     */
+    template<typename T>
+    class sync_ref<T, seqlock> {
+        friend class sync_owner<T, seqlock>;
+
+        T _data;
+
+        explicit sync_ref(const T & data) : _data(data) {}
+    public:
+        sync_ref(const sync_ref & other) = delete;
+        sync_ref(sync_ref && other) noexcept = delete;
+        sync_ref & operator=(const sync_ref & other) = delete;
+        sync_ref & operator=(sync_ref && other) noexcept = delete;
+
+        const T * operator->() const {
+            return &_data;
+        }
+
+        [[nodiscard]] operator safe::ref<T>() const {
+            return safe::ref<T>::create_from(_data);
+        }
+
+        [[nodiscard]] T value() const {
+            return _data;
+        }
+
+        [[nodiscard]] T clone() const {
+            return _data;
+        }
+    };
+
+    /**
+     * A sync_owner with a seqlock read path. Readers never write to shared memory, so they don't contend with
+     * each other at all; they only retry when a write happened while they were reading. The value is stored
+     * as atomic words, which is why this is only available for small, trivially copyable types.
+     */
+    template<typename T>
+    class sync_owner<T, seqlock> {
+        static_assert(std::is_trivially_copyable_v<T>, "A seqlock can only protect trivially copyable types.");
+        static_assert(sizeof(T) <= 256, "A seqlock is meant for small types, readers copy the whole value on every read.");
+
+        friend class sync_mut<T, seqlock>;
+
+        static constexpr size_t word_count = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+        mutable seqlock _lock;
+        std::array<std::atomic<uint64_t>, word_count> _words {};
+
+        [[nodiscard]] T load_unlocked() const {
+            uint64_t buffer[word_count];
+            for (size_t i = 0; i < word_count; ++i) {
+                buffer[i] = _words[i].load(std::memory_order_relaxed);
+            }
+            T value;
+            std::memcpy(&value, buffer, sizeof(T));
+            return value;
+        }
+
+        void store_unlocked(const T & value) {
+            uint64_t buffer[word_count] {};
+            std::memcpy(buffer, &value, sizeof(T));
+            for (size_t i = 0; i < word_count; ++i) {
+                _words[i].store(buffer[i], std::memory_order_relaxed);
+            }
+        }
+
+    public:
+        sync_owner() {
+            store_unlocked(T{});
+        }
+
+        template<typename... Args>
+        explicit sync_owner(Args&&... args) {
+            store_unlocked(T(std::forward<Args>(args)...));
+        }
+
+        sync_owner(const sync_owner & other) = delete;
+        sync_owner(sync_owner && other) noexcept = delete;
+        sync_owner & operator=(const sync_owner & other) = delete;
+        sync_owner & operator=(sync_owner && other) noexcept = delete;
+
+        [[nodiscard]] sync_mut<T, seqlock> mut() {
+            return sync_mut<T, seqlock>(*this);
+        }
+
+        [[nodiscard]] sync_ref<T, seqlock> ref() const {
+            return sync_ref<T, seqlock>(value());
+        }
+
+        /**
+         * @return A consistent copy of the value, without taking any lock.
+         */
+        [[nodiscard]] T value() const {
+            T result;
+            size_t sequence;
+            do {
+                sequence = _lock.read_begin();
+                result = load_unlocked();
+            } while (_lock.read_retry(sequence));
+            return result;
+        }
+    };
+}
+
+#endif //SYNC_OWNER_HPP
@@ -0,0 +1,468 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Laurens Ruijtenberg
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+#ifndef TASK_POOL_HPP
+#define TASK_POOL_HPP
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "cache_line.hpp"
+#include "index_ref.hpp"
+#include "mut.hpp"
+#include "ptr.hpp"
+#include "ref.hpp"
+#include "shared.hpp"
+#include "sync_owner.hpp"
+
+namespace safe {
+
+    namespace detail {
+        /* Types which borrow data that is owned somewhere else, a task must not take them along */
+        template<typename T> struct is_borrowed : std::false_type {};
+        template<typename T> struct is_borrowed<ref<T>> : std::true_type {};
+        template<typename T> struct is_borrowed<mut<T>> : std::true_type {};
+        template<typename T> struct is_borrowed<ref_ptr<T>> : std::true_type {};
+        template<typename T> struct is_borrowed<ptr<T>> : std::true_type {};
+        template<typename T> struct is_borrowed<index_ref<T>> : std::true_type {};
+        template<typename C> struct is_borrowed<static_index_ref<C>> : std::true_type {};
+        template<typename T, typename L> struct is_borrowed<sync_ref<T, L>> : std::true_type {};
+        template<typename T, typename L> struct is_borrowed<sync_mut<T, L>> : std::true_type {};
+        template<typename T> struct is_borrowed<std::reference_wrapper<T>> : std::true_type {};
+        template<typename T, size_t Extent> struct is_borrowed<std::span<T, Extent>> : std::true_type {};
+        template<typename C, typename Traits> struct is_borrowed<std::basic_string_view<C, Traits>> : std::true_type {};
+
+        /* Types which must stay on the thread that created them */
+        template<typename T> struct is_thread_bound : std::false_type {};
+        template<typename T> struct is_thread_bound<shared<T, shared_mode::single_thread>> : std::true_type {};
+
+        template<typename T>
+        struct is_owned : std::bool_constant<!is_borrowed<T>::value && !is_thread_bound<T>::value && !std::is_pointer_v<T>> {};
+
+        /* A reference or a borrow nested in a standard wrapper is just as unsafe to send as a top-level one, so the
+         * wrappers are checked element by element. Members of other class types can't be inspected. */
+        template<typename T>
+        inline constexpr bool is_sendable_v = !std::is_reference_v<T> && is_owned<std::remove_cv_t<T>>::value;
+
+        template<typename... Ts> struct is_owned<std::tuple<Ts...>> : std::bool_constant<(is_sendable_v<Ts> && ...)> {};
+        template<typename A, typename B> struct is_owned<std::pair<A, B>> : std::bool_constant<is_sendable_v<A> && is_sendable_v<B>> {};
+        template<typename T> struct is_owned<std::optional<T>> : std::bool_constant<is_sendable_v<T>> {};
+        template<typename... Ts> struct is_owned<std::variant<Ts...>> : std::bool_constant<(is_sendable_v<Ts> && ...)> {};
+        template<typename T, size_t N> struct is_owned<std::array<T, N>> : std::bool_constant<is_sendable_v<T>> {};
+        template<typename T, typename Alloc> struct is_owned<std::vector<T, Alloc>> : std::bool_constant<is_sendable_v<T>> {};
+    }
+
+    /**
+     * A type which can be handed to a task that outlives the caller: it owns its data, so it isn't a safe borrow type
+     * (ref, mut, ref_ptr, ptr, index_ref, sync_ref, sync_mut), a std::span, std::string_view, raw pointer or
+     * std::reference_wrapper, and it isn't bound to its thread like a single_thread safe::shared. The same holds for
+     * the elements of a std::tuple, pair, optional, variant, array or vector, which also must not be references.
+     */
+    template<typename T>
+    concept sendable = detail::is_sendable_v<std::decay_t<T>>
+        && std::is_move_constructible_v<std::decay_t<T>>;
+
+    namespace detail {
+        struct task_base {
+            virtual ~task_base() = default;
+            virtual void run() = 0;
+        };
+
+        template<typename Fn>
+        struct task_impl final : task_base {
+            Fn fn;
+            explicit task_impl(Fn && f) : fn(std::move(f)) {}
+            void run() override { fn(); }
+        };
+
+        template<typename Fn>
+        task_base * make_task(Fn && fn) {
+            return new task_impl<std::decay_t<Fn>>(std::forward<Fn>(fn));
+        }
+
+        /*
+         * The work-stealing deque of Chase and Lev, with the memory orderings of Lê et al. The owning thread pushes and
+         * pops at the bottom, other threads steal from the top. Arrays which were outgrown are kept until the deque is
+         * destroyed, because a thief may still be reading from them.
+         */
+        class chase_lev_deque {
+            struct ring {
+                size_t capacity;
+                std::unique_ptr<std::atomic<task_base *>[]> slots;
+
+                explicit ring(const size_t size) : capacity(size), slots(std::make_unique<std::atomic<task_base *>[]>(size)) {}
+
+                task_base * get(const int64_t index) const {
+                    return slots[static_cast<size_t>(index) & (capacity - 1)].load(std::memory_order_relaxed);
+                }
+
+                void put(const int64_t index, task_base * task) {
+                    slots[static_cast<size_t>(index) & (capacity - 1)].store(task, std::memory_order_relaxed);
+                }
+            };
+
+            alignas(cache_line_size) std::atomic<int64_t> _top = 0;
+            alignas(cache_line_size) std::atomic<int64_t> _bottom = 0;
+            alignas(cache_line_size) std::atomic<ring *> _ring;
+            std::vector<std::unique_ptr<ring>> _rings;
+
+            ring * grow(const ring * current, const int64_t bottom, const int64_t top) {
+                auto bigger = std::make_unique<ring>(current->capacity * 2);
+                for (int64_t i = top; i < bottom; ++i) {
+                    bigger->put(i, current->get(i));
+                }
+                ring * result = bigger.get();
+                _rings.push_back(std::move(bigger));
+                _ring.store(result, std::memory_order_release);
+                return result;
+            }
+
+        public:
+            explicit chase_lev_deque(const size_t capacity = 256) {
+                _rings.push_back(std::make_unique<ring>(capacity));
+                _ring.store(_rings.back().get(), std::memory_order_relaxed);
+            }
+
+            chase_lev_deque(const chase_lev_deque &) = delete;
+            chase_lev_deque & operator=(const chase_lev_deque &) = delete;
+
+            /* Only called by the owning thread */
+            void push(task_base * task) {
+                const int64_t bottom = _bottom.load(std::memory_order_relaxed);
+                const int64_t top = _top.load(std::memory_order_acquire);
+                ring * current = _ring.load(std::memory_order_relaxed);
+                if (bottom - top > static_cast<int64_t>(current->capacity) - 1) {
+                    current = grow(current, bottom, top);
+                }
+                current->put(bottom, task);
+                //a release store instead of Lê et al.'s release fence and relaxed store, it orders the same but
+                //ThreadSanitizer can follow it, it doesn't model standalone fences
+                _bottom.store(bottom + 1, std::memory_order_release);
+            }
+
+            /* Only called by the owning thread, returns nullptr when the deque is empty */
+            task_base * pop() {
+                const int64_t bottom = _bottom.load(std::memory_order_relaxed) - 1;
+                const ring * current = _ring.load(std::memory_order_relaxed);
+                _bottom.store(bottom, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                int64_t top = _top.load(std::memory_order_relaxed);
+
+                if (top > bottom) {
+                    _bottom.store(bottom + 1, std::memory_order_relaxed);
+                    return nullptr;
+                }
+
+                task_base * task = current->get(bottom);
+                if (top == bottom) {
+                    //the last element, race the thieves for it
+                    if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                        task = nullptr;
+                    }
+                    _bottom.store(bottom + 1, std::memory_order_relaxed);
+                }
+                return task;
+            }
+
+            /* Called by any thread, returns nullptr when the deque is empty or the steal lost a race */
+            task_base * steal() {
+                int64_t top = _top.load(std::memory_order_acquire);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                const int64_t bottom = _bottom.load(std::memory_order_acquire);
+                if (top >= bottom) {
+                    return nullptr;
+                }
+
+                const ring * current = _ring.load(std::memory_order_acquire);
+                task_base * task = current->get(top);
+                if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                    return nullptr;
+                }
+                return task;
+            }
+        };
+    }
+
+    class task_pool;
+
+    /**
+     * A structured join scope, created by task_pool::scope. Tasks which are spawned in a scope are joined before the
+     * scope returns, so unlike task_pool::submit they may borrow data from the enclosing function.
+     */
+    class task_scope {
+        friend class task_pool;
+
+        task_pool & _pool;
+        std::atomic<size_t> _remaining = 0;
+        std::mutex _error_mutex;
+        std::exception_ptr _error;
+
+        explicit task_scope(task_pool & pool) : _pool(pool) {}
+
+        void join();
+
+    public:
+        task_scope(const task_scope &) = delete;
+        task_scope & operator=(const task_scope &) = delete;
+
+        /**
+         * Runs fn on the pool. The first exception thrown by a task of the scope is rethrown when the scope is joined.
+         * @param fn Any callable, it may capture references to data that outlives the scope.
+         */
+        template<typename Fn>
+        void spawn(Fn && fn);
+    };
+
+    /**
+     * A work-stealing thread pool. Every worker has its own Chase-Lev deque: tasks which are submitted from a worker go
+     * to its own deque, tasks from other threads go to a shared queue, and idle workers steal from the others.
+     *
+     * Detached tasks (submit) can outlive the caller, so they only accept a captureless callable and sendable
+     * arguments which are moved into the task. Borrowing is only possible in a structured scope (scope).
+     * Destroying the pool waits for all submitted tasks.
+     */
+    class task_pool {
+        friend class task_scope;
+
+        struct alignas(cache_line_size) worker {
+            detail::chase_lev_deque deque;
+        };
+
+        std::vector<std::unique_ptr<worker>> _workers;
+        std::mutex _shared_mutex;
+        std::deque<detail::task_base *> _shared;
+
+        alignas(cache_line_size) std::atomic<size_t> _pending = 0;
+        alignas(cache_line_size) std::atomic<size_t> _sleeping = 0;
+        std::atomic<bool> _stop = false;
+        std::mutex _mutex;
+        std::condition_variable _wake;
+        std::vector<std::jthread> _threads;
+
+        struct current_worker {
+            const task_pool * pool = nullptr;
+            size_t index = 0;
+        };
+
+        static current_worker & current() {
+            thread_local current_worker worker;
+            return worker;
+        }
+
+        void push(detail::task_base * task) {
+            const current_worker & self = current();
+            if (self.pool == this) {
+                _workers[self.index]->deque.push(task);
+            } else {
+                std::lock_guard lock(_shared_mutex);
+                _shared.push_back(task);
+            }
+
+            _pending.fetch_add(1, std::memory_order_seq_cst);
+            if (_sleeping.load(std::memory_order_seq_cst) > 0) {
+                std::lock_guard lock(_mutex);
+                _wake.notify_one();
+            }
+        }
+
+        detail::task_base * take_shared() {
+            std::lock_guard lock(_shared_mutex);
+            if (_shared.empty()) return nullptr;
+            detail::task_base * task = _shared.front();
+            _shared.pop_front();
+            return task;
+        }
+
+        detail::task_base * find_task(const size_t start, const bool own) {
+            if (own) {
+                if (auto * task = _workers[start]->deque.pop()) return task;
+            }
+            if (auto * task = take_shared()) return task;
+            for (size_t i = 0; i < _workers.size(); ++i) {
+                if (auto * task = _workers[(start + i) % _workers.size()]->deque.steal()) return task;
+            }
+            return nullptr;
+        }
+
+        void execute(detail::task_base * task) {
+            _pending.fetch_sub(1, std::memory_order_relaxed);
+            task->run();
+            delete task;
+        }
+
+        /* Runs one queued task on the calling thread, used to help while joining a scope */
+        bool run_one() {
+            const current_worker & self = current();
+            auto * task = self.pool == this ? find_task(self.index, true) : find_task(0, false);
+            if (task == nullptr) return false;
+            execute(task);
+            return true;
+        }
+
+        void work(const size_t index) {
+            current() = { this, index };
+            for (;;) {
+                if (auto * task = find_task(index, true)) {
+                    execute(task);
+                    continue;
+                }
+                if (_stop.load(std::memory_order_acquire) && _pending.load(std::memory_order_acquire) == 0) {
+                    return;
+                }
+
+                _sleeping.fetch_add(1, std::memory_order_seq_cst);
+                {
+                    std::unique_lock lock(_mutex);
+                    _wake.wait(lock, [&] { return _stop.load() || _pending.load() > 0; });
+                }
+                _sleeping.fetch_sub(1, std::memory_order_seq_cst);
+            }
+        }
+
+    public:
+        /**
+         * Starts the workers.
+         * @param threads The number of worker threads, 0 uses every hardware thread.
+         */
+        explicit task_pool(size_t threads = 0) {
+            if (threads == 0) {
+                threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+            }
+            for (size_t i = 0; i < threads; ++i) {
+                _workers.push_back(std::make_unique<worker>());
+            }
+            for (size_t i = 0; i < threads; ++i) {
+                _threads.emplace_back([this, i] { work(i); });
+            }
+        }
+
+        ~task_pool() {
+            {
+                std::lock_guard lock(_mutex);
+                _stop.store(true, std::memory_order_release);
+            }
+            _wake.notify_all();
+            _threads.clear();
+        }
+
+        task_pool(const task_pool &) = delete;
+        task_pool & operator=(const task_pool &) = delete;
+
+        [[nodiscard]] size_t size() const {
+            return _workers.size();
+        }
+
+        /**
+         * Runs fn(args...) on the pool without waiting for it. The task may outlive the caller, so fn can't capture
+         * anything and the arguments are moved into the task, which is why they must be sendable.
+         * An exception which escapes a detached task terminates the program, like it does for std::thread.
+         * @param fn A captureless callable, e.g. a lambda without captures or a function pointer.
+         * @param args The arguments of fn, e.g. values or safe::owner instances, but never a borrow.
+         */
+        template<typename Fn, typename... Args>
+            requires (std::is_empty_v<std::decay_t<Fn>> || std::is_function_v<std::remove_pointer_t<std::decay_t<Fn>>>)
+                && std::is_invocable_v<std::decay_t<Fn>, std::decay_t<Args>...>
+        void submit(Fn && fn, Args &&... args) {
+            static_assert((sendable<Args> && ...), "A detached task can't take a borrow (ref, mut, ref_ptr, ptr, index_ref, span, string_view, pointer, reference) or a thread bound value along, use an owned value or a scope.");
+            push(detail::make_task([fn = std::forward<Fn>(fn), ...values = std::decay_t<Args>(std::forward<Args>(args))]() mutable noexcept {
+                std::invoke(std::move(fn), std::move(values)...);
+            }));
+        }
+
+        /**
+         * Runs body with a task_scope and joins all tasks which were spawned in it before returning. While joining,
+         * the calling thread runs queued tasks itself, so a scope can also be used from inside a task.
+         * @param body Called as body(task_scope &).
+         * @throws The first exception thrown by body or by one of the spawned tasks.
+         */
+        template<typename Fn>
+        void scope(Fn && body) {
+            task_scope scope(*this);
+#if defined(__cpp_exceptions) || defined(_CPPUNWIND)
+            try {
+                std::forward<Fn>(body)(scope);
+            } catch (...) {
+                scope.join();
+                throw;
+            }
+#else
+            std::forward<Fn>(body)(scope);
+#endif
+            scope.join();
+            if (scope._error) {
+                std::rethrow_exception(scope._error);
+            }
+        }
+    };
+
+    template<typename Fn>
+    void task_scope::spawn(Fn && fn) {
+        _remaining.fetch_add(1, std::memory_order_relaxed);
+        _pool.push(detail::make_task([this, fn = std::forward<Fn>(fn)]() mutable {
+            {
+                //the callable is destroyed before the scope learns it is done, as it may hold borrowed data
+                auto local = std::move(fn);
+#if defined(__cpp_exceptions) || defined(_CPPUNWIND)
+                try {
+                    local();
+                } catch (...) {
+                    std::lock_guard lock(_error_mutex);
+                    if (!_error) _error = std::current_exception();
+                }
+#else
+                local();
+#endif
+            }
+            _remaining.fetch_sub(1, std::memory_order_release);
+        }));
+    }
+
+    inline void task_scope::join() {
+        while (_remaining.load(std::memory_order_acquire) != 0) {
+            if (!_pool.run_one()) {
+                std::this_thread::yield();
+            }
+        }
+    }
+}
+
+#endif //TASK_POOL_HPP
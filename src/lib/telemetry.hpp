@@ -0,0 +1,248 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Laurens Ruijtenberg
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+#ifndef TELEMETRY_HPP
+#define TELEMETRY_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "cache_line.hpp"
+
+/*
+ * Opt-in counters for the safety checks of the library, enabled with the SAFE_TELEMETRY CMake option on the safelib
+ * target. Every thread counts into its own cache line padded block, so recording is a plain load and store without
+ * any contention. Without SAFE_TELEMETRY the record functions are empty and the checks compile to exactly what they
+ * were without instrumentation.
+ */
+namespace safe {
+
+    /* The places in the library which report to the telemetry */
+    enum class check_site : uint8_t {
+        memory_access,
+        ranged_construct,
+        ranged_clamped,
+        index_ref_is_valid,
+        index_ref_value,
+        ptr_is_valid,
+        safe_assert,
+        shared_value,
+        other
+    };
+
+    inline constexpr size_t check_site_count = static_cast<size_t>(check_site::other) + 1;
+
+    [[nodiscard]] constexpr const char * check_site_name(const check_site site) {
+        switch (site) {
+            case check_site::memory_access: return "memory_access";
+            case check_site::ranged_construct: return "ranged_construct";
+            case check_site::ranged_clamped: return "ranged_clamped";
+            case check_site::index_ref_is_valid: return "index_ref_is_valid";
+            case check_site::index_ref_value: return "index_ref_value";
+            case check_site::ptr_is_valid: return "ptr_is_valid";
+            case check_site::safe_assert: return "safe_assert";
+            case check_site::shared_value: return "shared_value";
+            case check_site::other: return "other";
+        }
+        return "other";
+    }
+
+    struct telemetry_counters {
+        uint64_t checks = 0;
+        uint64_t failures = 0;
+        uint64_t clamps = 0;
+    };
+
+    namespace detail {
+        enum telemetry_counter : size_t { counter_checks, counter_failures, counter_clamps, counter_count };
+
+        struct alignas(cache_line_size) telemetry_block {
+            std::array<std::array<std::atomic<uint64_t>, counter_count>, check_site_count> counters{};
+
+            //only the owning thread writes, so a relaxed load and store is enough and avoids a locked instruction
+            void add(const check_site site, const telemetry_counter counter) noexcept {
+                auto &value = counters[static_cast<size_t>(site)][counter];
+                value.store(value.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+        };
+
+        /* Keeps track of the blocks of the running threads and the totals of the threads which already exited */
+        class telemetry_registry {
+            std::mutex _mutex;
+            std::vector<const telemetry_block *> _blocks;
+            std::array<std::array<uint64_t, counter_count>, check_site_count> _retired{};
+
+        public:
+            static telemetry_registry & instance() {
+                static telemetry_registry registry;
+                return registry;
+            }
+
+            void attach(const telemetry_block * block) {
+                std::lock_guard lock(_mutex);
+                _blocks.push_back(block);
+            }
+
+            void detach(const telemetry_block * block) {
+                std::lock_guard lock(_mutex);
+                for (size_t site = 0; site < check_site_count; ++site) {
+                    for (size_t counter = 0; counter < counter_count; ++counter) {
+                        _retired[site][counter] += block->counters[site][counter].load(std::memory_order_relaxed);
+                    }
+                }
+                std::erase(_blocks, block);
+            }
+
+            std::array<std::array<uint64_t, counter_count>, check_site_count> totals() {
+                std::lock_guard lock(_mutex);
+                auto totals = _retired;
+                for (const telemetry_block * block : _blocks) {
+                    for (size_t site = 0; site < check_site_count; ++site) {
+                        for (size_t counter = 0; counter < counter_count; ++counter) {
+                            totals[site][counter] += block->counters[site][counter].load(std::memory_order_relaxed);
+                        }
+                    }
+                }
+                return totals;
+            }
+        };
+
+        struct telemetry_thread {
+            telemetry_block block;
+
+            telemetry_thread() { telemetry_registry::instance().attach(&block); }
+            ~telemetry_thread() { telemetry_registry::instance().detach(&block); }
+        };
+
+        inline telemetry_block & local_telemetry() {
+            thread_local telemetry_thread thread;
+            return thread.block;
+        }
+
+        constexpr void telemetry_record_check(const check_site site, const bool passed) noexcept {
+#ifdef SAFE_TELEMETRY
+            if !consteval {
+                telemetry_block &block = local_telemetry();
+                block.add(site, counter_checks);
+                if (!passed) [[unlikely]] {
+                    block.add(site, counter_failures);
+                }
+            }
+#else
+            (void) site;
+            (void) passed;
+#endif
+        }
+
+        constexpr void telemetry_record_clamp(const check_site site) noexcept {
+#ifdef SAFE_TELEMETRY
+            if !consteval {
+                local_telemetry().add(site, counter_clamps);
+            }
+#else
+            (void) site;
+#endif
+        }
+    }
+
+    /**
+     * The counters of all threads at the moment of the capture, including the threads which already exited.
+     * Without SAFE_TELEMETRY every counter is zero.
+     */
+    class telemetry_snapshot {
+        std::array<telemetry_counters, check_site_count> _sites{};
+
+    public:
+        [[nodiscard]] static constexpr bool enabled() {
+#ifdef SAFE_TELEMETRY
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        [[nodiscard]] static telemetry_snapshot capture() {
+            telemetry_snapshot snapshot;
+#ifdef SAFE_TELEMETRY
+            const auto totals = detail::telemetry_registry::instance().totals();
+            for (size_t site = 0; site < check_site_count; ++site) {
+                snapshot._sites[site] = {
+                    totals[site][detail::counter_checks],
+                    totals[site][detail::counter_failures],
+                    totals[site][detail::counter_clamps]
+                };
+            }
+#endif
+            return snapshot;
+        }
+
+        [[nodiscard]] const telemetry_counters & operator[](const check_site site) const {
+            return _sites[static_cast<size_t>(site)];
+        }
+
+        /**
+         * @return The counters as a JSON object with one member per check site, e.g. {"memory_access":{"checks":10,"failures":0,"clamps":0}}.
+         */
+        [[nodiscard]] std::string to_json() const {
+            std::string json = "{";
+            for (size_t site = 0; site < check_site_count; ++site) {
+                const telemetry_counters &counters = _sites[site];
+                if (site != 0) json += ',';
+                json += '"';
+                json += check_site_name(static_cast<check_site>(site));
+                json += "\":{\"checks\":" + std::to_string(counters.checks)
+                      + ",\"failures\":" + std::to_string(counters.failures)
+                      + ",\"clamps\":" + std::to_string(counters.clamps) + '}';
+            }
+            json += '}';
+            return json;
+        }
+
+        /**
+         * @return The counters in the Prometheus text exposition format, labelled by check site.
+         */
+        [[nodiscard]] std::string to_prometheus() const {
+            std::string text;
+            const auto metric = [&](const char * name, const char * help, uint64_t telemetry_counters::* member) {
+                text += std::string("# HELP ") + name + ' ' + help + "\n# TYPE " + name + " counter\n";
+                for (size_t site = 0; site < check_site_count; ++site) {
+                    text += std::string(name) + "{site=\"" + check_site_name(static_cast<check_site>(site)) + "\"} "
+                          + std::to_string(_sites[site].*member) + '\n';
+                }
+            };
+            metric("safe_checks_total", "Safety checks performed.", &telemetry_counters::checks);
+            metric("safe_check_failures_total", "Safety checks which failed.", &telemetry_counters::failures);
+            metric("safe_clamps_total", "Values which were clamped into range.", &telemetry_counters::clamps);
+            return text;
+        }
+    };
+}
+
+#endif //TELEMETRY_HPP
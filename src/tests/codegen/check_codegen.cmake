@@ -0,0 +1,218 @@
+# Compiles snippets.cpp to assembly at -O2 and -O3 and checks the code of every snippet.
+#
+# The invariants below hold for every compiler and are always checked. On top of that the normalized instructions
+# are compared with the checked-in baseline of the compiler, so any change in the emitted code shows up. When a
+# change is intended, regenerate the baseline with the codegen_baseline target and commit it with the change.
+#
+#   cmake -DCOMPILER=<c++ compiler> -DINCLUDE_DIR=<src/lib> -DSOURCE=<snippets.cpp> -DWORK_DIR=<dir>
+#         -DBASELINE=<baseline file> -DSTANDARD_FLAG=<flag of the project standard> [-DEXTRA_FLAGS=<list>] [-DUPDATE=ON]
+#         -P check_codegen.cmake
+#
+# The standard flag comes from the compiler (CMAKE_CXX26_STANDARD_COMPILE_OPTION), so baselines can only be made
+# with a compiler which builds the library as it is.
+
+cmake_minimum_required(VERSION 3.25)
+
+if(NOT STANDARD_FLAG)
+    message(FATAL_ERROR "STANDARD_FLAG is required, pass the standard flag of the compiler")
+endif()
+
+set(snippets
+    codegen_raw_memory_get_loop
+    codegen_safe_memory_get_loop
+    codegen_unchecked_memory_get_loop
+    codegen_raw_pointer_loop
+    codegen_span_loop
+    codegen_raw_int_arithmetic
+    codegen_owner_int_arithmetic
+    codegen_raw_field_access
+    codegen_ref_field_access
+)
+set(levels O2 O3)
+
+set(call_regex "^(call[a-z]*|bl|blr)[ \t]")
+set(tail_call_regex "^(jmp|b)[ \t]+[_A-Za-z]")
+set(exception_regex "__cxa_throw|__cxa_allocate_exception|_Unwind_Resume")
+set(branch_regex "^(j[a-ln-z][a-z]*|b\\.[a-z]+|cbn?z|tbn?z)[ \t]")
+set(jump_regex "^(j[a-z]+|b|b\\.[a-z]+|cbn?z|tbn?z)[ \t]")
+set(label_regex "\\.?L[A-Za-z]*[0-9_]+")
+set(memory_regex "\\(|\\[")
+set(no_memory_regex "^(lea|nop|prefetch)")
+set(vector_regex "%[xyz]mm[0-9]|[ \t,]v[0-9]+\\.|[ \t,]q[0-9]+")
+
+set(failures "")
+macro(fail message)
+    list(APPEND failures "${message}")
+endmacro()
+
+# Counts the memory operands of the instructions inside loops, a loop being the code between a label and a branch
+# back to it. The code still has its labels, written as "<label>:".
+function(count_loop_memory_operands code result)
+    set(index 0)
+    set(in_loop "")
+    foreach(entry IN LISTS code)
+        if(entry MATCHES "^(.+):$")
+            set(label_${CMAKE_MATCH_1} ${index})
+        elseif(entry MATCHES "${jump_regex}" AND entry MATCHES "[ \t,](${label_regex})$")
+            if(DEFINED label_${CMAKE_MATCH_1})
+                foreach(position RANGE ${label_${CMAKE_MATCH_1}} ${index})
+                    list(APPEND in_loop ${position})
+                endforeach()
+            endif()
+        endif()
+        math(EXPR index "${index} + 1")
+    endforeach()
+
+    set(count 0)
+    set(index 0)
+    foreach(entry IN LISTS code)
+        if(index IN_LIST in_loop AND entry MATCHES "${memory_regex}" AND NOT entry MATCHES "${no_memory_regex}")
+            math(EXPR count "${count} + 1")
+        endif()
+        math(EXPR index "${index} + 1")
+    endforeach()
+    set(${result} ${count} PARENT_SCOPE)
+endfunction()
+
+file(MAKE_DIRECTORY "${WORK_DIR}")
+set(current "")
+
+foreach(level IN LISTS levels)
+    set(assembly "${WORK_DIR}/snippets-${level}.s")
+    execute_process(
+        COMMAND "${COMPILER}" ${STANDARD_FLAG} -${level} -S -DSAFE_CHECK_POLICY_THROW ${EXTRA_FLAGS}
+                -I "${INCLUDE_DIR}" "${SOURCE}" -o "${assembly}"
+        RESULT_VARIABLE result
+        ERROR_VARIABLE errors
+    )
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "Compiling the snippets at -${level} failed:\n${errors}")
+    endif()
+
+    # Splits the assembly per snippet. A .cold part (the outlined failure path) belongs to its snippet, local labels
+    # are renamed to .L so the baseline doesn't change when unrelated code is added. The loop check needs to know
+    # where the branches go, so it gets a second copy with the labels kept.
+    foreach(name IN LISTS snippets)
+        set(${level}_${name} "")
+        set(${level}_${name}_labeled "")
+    endforeach()
+    set(function "")
+    file(STRINGS "${assembly}" lines)
+    foreach(line IN LISTS lines)
+        if(line MATCHES "^_?(codegen_[a-z_]+)(\\.cold)?:")
+            set(function "${CMAKE_MATCH_1}")
+            if(CMAKE_MATCH_2)
+                list(APPEND ${level}_${function} "cold:")
+            endif()
+        elseif(line MATCHES "\\.cfi_endproc|^[ \t]*\\.size[ \t]")
+            set(function "")
+        elseif(function AND line MATCHES "^(${label_regex}):")
+            list(APPEND ${level}_${function}_labeled "${CMAKE_MATCH_1}:")
+        elseif(function AND line MATCHES "^[ \t]+([a-z][^#@/]*)")
+            string(STRIP "${CMAKE_MATCH_1}" instruction)
+            string(REGEX REPLACE "[ \t]+" " " instruction "${instruction}")
+            list(APPEND ${level}_${function}_labeled "${instruction}")
+            string(REGEX REPLACE "${label_regex}" ".L" instruction "${instruction}")
+            list(APPEND ${level}_${function} "${instruction}")
+        endif()
+    endforeach()
+
+    foreach(name IN LISTS snippets)
+        set(code "${${level}_${name}}")
+        if(NOT code)
+            fail("-${level} ${name}: not found in the assembly")
+            continue()
+        endif()
+
+        string(APPEND current "## -${level} ${name}\n")
+        foreach(instruction IN LISTS code)
+            string(APPEND current "${instruction}\n")
+        endforeach()
+
+        # A throw in a snippet means the failure path was inlined instead of going through the outlined check_throw
+        if(code MATCHES "${exception_regex}")
+            fail("-${level} ${name}: throws or unwinds inline")
+        endif()
+
+        # The only call a snippet may make is the outlined failure path of a check, which is never taken in the loop
+        foreach(instruction IN LISTS code)
+            if(instruction MATCHES "${call_regex}" OR instruction MATCHES "${tail_call_regex}")
+                if(NOT name MATCHES "_safe_|_span_" OR NOT instruction MATCHES "check")
+                    fail("-${level} ${name}: unexpected call '${instruction}'")
+                endif()
+            endif()
+        endforeach()
+    endforeach()
+
+    # Wrappers which hold a value or a reference must compile to exactly the raw code
+    if(NOT "${${level}_codegen_owner_int_arithmetic}" STREQUAL "${${level}_codegen_raw_int_arithmetic}")
+        fail("-${level} owner<int> arithmetic differs from raw int arithmetic")
+    endif()
+    if(NOT "${${level}_codegen_ref_field_access}" STREQUAL "${${level}_codegen_raw_field_access}")
+        fail("-${level} ref<T> field access differs from raw pointer field access")
+    endif()
+
+    # Without a check per element the loops must vectorize whenever the raw loop does
+    if("${${level}_codegen_raw_pointer_loop}" MATCHES "${vector_regex}")
+        foreach(name codegen_unchecked_memory_get_loop codegen_span_loop)
+            if(NOT "${${level}_${name}}" MATCHES "${vector_regex}")
+                fail("-${level} ${name}: not vectorized while the raw pointer loop is")
+            endif()
+        endforeach()
+    endif()
+
+    # No extra branches: the unchecked loop has none on top of the raw pointer loop, the checked loop at most the
+    # one of its bounds check on top of a raw loop which stays within the block by hand
+    foreach(name IN LISTS snippets)
+        set(${name}_branches 0)
+        foreach(instruction IN LISTS ${level}_${name})
+            if(instruction MATCHES "${branch_regex}")
+                math(EXPR ${name}_branches "${${name}_branches} + 1")
+            endif()
+        endforeach()
+    endforeach()
+    if(codegen_unchecked_memory_get_loop_branches GREATER codegen_raw_pointer_loop_branches)
+        fail("-${level} unchecked memory::get loop has ${codegen_unchecked_memory_get_loop_branches} conditional branches, the raw pointer loop ${codegen_raw_pointer_loop_branches}")
+    endif()
+    math(EXPR allowed "${codegen_raw_memory_get_loop_branches} + 1")
+    if(codegen_safe_memory_get_loop_branches GREATER allowed)
+        fail("-${level} memory::get loop has ${codegen_safe_memory_get_loop_branches} conditional branches, the raw loop ${codegen_raw_memory_get_loop_branches}")
+    endif()
+
+    # No extra loads: inside their loops the wrappers touch memory as often as the raw loops do, so nothing the
+    # raw loop keeps in a register (the base pointer, the size) is reloaded per element
+    foreach(name IN LISTS snippets)
+        count_loop_memory_operands("${${level}_${name}_labeled}" ${name}_loads)
+    endforeach()
+    foreach(pair
+            codegen_safe_memory_get_loop:codegen_raw_memory_get_loop
+            codegen_unchecked_memory_get_loop:codegen_raw_pointer_loop
+            codegen_span_loop:codegen_raw_pointer_loop)
+        string(REPLACE ":" ";" pair "${pair}")
+        list(GET pair 0 name)
+        list(GET pair 1 raw)
+        if(${name}_loads GREATER ${raw}_loads)
+            fail("-${level} ${name}: ${${name}_loads} memory operands in its loops, ${raw} ${${raw}_loads}")
+        endif()
+    endforeach()
+endforeach()
+
+file(WRITE "${WORK_DIR}/codegen.txt" "${current}")
+
+if(UPDATE)
+    file(WRITE "${BASELINE}" "${current}")
+    message(STATUS "Wrote ${BASELINE}")
+elseif(EXISTS "${BASELINE}")
+    file(READ "${BASELINE}" baseline)
+    if(NOT baseline STREQUAL current)
+        fail("the emitted code differs from the baseline, compare ${WORK_DIR}/codegen.txt with ${BASELINE}")
+    endif()
+else()
+    message(STATUS "No baseline ${BASELINE} for this compiler, only the invariants were checked")
+endif()
+
+if(failures)
+    list(JOIN failures "\n  " report)
+    message(FATAL_ERROR "Codegen check failed:\n  ${report}")
+endif()
+message(STATUS "Codegen check passed")
@@ -0,0 +1,104 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Laurens Ruijtenberg
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "safe.hpp"
+
+/*
+ * Canonical snippets in raw and safe form, compiled to assembly by check_codegen.cmake. The functions are extern "C"
+ * so the script can find them without demangling, and noinline so every one of them gets its own body. Each safe
+ * snippet has a raw counterpart which takes its data the same way (by reference or pointer), so any extra call,
+ * branch or load in the safe form is the cost of the wrapper.
+ */
+extern "C" {
+    struct codegen_point {
+        int x;
+        int y;
+    };
+
+    [[gnu::noinline]] uint64_t codegen_raw_memory_get_loop(const std::byte * bytes, const size_t size, const size_t count) {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < count; ++i) {
+            //the raw form still has to stay within the block, otherwise the comparison isn't fair
+            if (i * sizeof(uint32_t) + sizeof(uint32_t) >= size) break;
+            uint32_t value;
+            std::memcpy(&value, bytes + i * sizeof(uint32_t), sizeof(value));
+            sum += value;
+        }
+        return sum;
+    }
+
+    [[gnu::noinline]] uint64_t codegen_safe_memory_get_loop(const safe::memory & bytes, const size_t count) {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < count; ++i) {
+            sum += bytes.get<uint32_t>(i * sizeof(uint32_t)).value();
+        }
+        return sum;
+    }
+
+    [[gnu::noinline]] uint64_t codegen_unchecked_memory_get_loop(const safe::memory & bytes, const size_t count) {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < count; ++i) {
+            sum += bytes.get<uint32_t, safe::unsafe_unchecked>(i * sizeof(uint32_t)).value();
+        }
+        return sum;
+    }
+
+    [[gnu::noinline]] uint64_t codegen_raw_pointer_loop(const uint32_t * values, const size_t count) {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < count; ++i) {
+            sum += values[i];
+        }
+        return sum;
+    }
+
+    [[gnu::noinline]] uint64_t codegen_span_loop(const safe::memory & bytes, const size_t count) {
+        uint64_t sum = 0;
+        for (const uint32_t value : bytes.span<uint32_t>(0, count).value()) {
+            sum += value;
+        }
+        return sum;
+    }
+
+    [[gnu::noinline]] int codegen_raw_int_arithmetic(const int & a, const int & b) {
+        return a * b + a;
+    }
+
+    [[gnu::noinline]] int codegen_owner_int_arithmetic(const safe::owner<int> & a, const safe::owner<int> & b) {
+        return a * b + a;
+    }
+
+    [[gnu::noinline]] int codegen_raw_field_access(const codegen_point * const & p) {
+        return p->x + p->y;
+    }
+
+    [[gnu::noinline]] int codegen_ref_field_access(const safe::ref<codegen_point> & p) {
+        return p->x + p->y;
+    }
+}
@@ -0,0 +1,140 @@
+/*
+    MIT License
+
+    Copyright (c) 2025 Laurens Ruijtenberg
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+
+#include <atomic>
+#include <cstdlib>
+#include <print>
+#include <thread>
+#include <vector>
+
+import safe;
+
+/*
+ * Hammers the task_pool from several directions at once: detached tasks which keep submitting while the pool is
+ * being destroyed, nested scopes joined from several outside threads, and submits from several threads together.
+ * Every test counts the tasks that ran, a lost or doubly run task shows up as a wrong count, a race as a hang or
+ * as a report when the test is built with -fsanitize=thread.
+ */
+namespace {
+    constexpr int rounds = 50;
+    constexpr int depth = 10;
+
+    std::atomic<size_t> ran = 0;
+    int failures = 0;
+
+    //detached tasks can't take a pointer along, so the pool they submit to is reached through a global
+    safe::task_pool * fan_out_pool = nullptr;
+
+    void expect(const bool condition, const char * what, const size_t actual, const size_t expected) {
+        if (!condition) {
+            std::print("FAILED: {}, got {} instead of {}\n", what, actual, expected);
+            ++failures;
+        }
+    }
+
+    //every task submits two more until depth runs out, so submits keep coming from the workers after the pool is
+    //already shutting down
+    void fan_out(const int remaining) {
+        ran.fetch_add(1, std::memory_order_relaxed);
+        if (remaining == 0) return;
+        fan_out_pool->submit(fan_out, remaining - 1);
+        fan_out_pool->submit(fan_out, remaining - 1);
+    }
+
+    void shutdown_while_submitting() {
+        constexpr size_t expected = (size_t { 2 } << depth) - 1;
+        for (int round = 0; round < rounds; ++round) {
+            ran = 0;
+            {
+                safe::task_pool pool(4);
+                fan_out_pool = &pool;
+                pool.submit(fan_out, depth);
+            }
+            expect(ran == expected, "tasks submitted during shutdown", ran, expected);
+        }
+    }
+
+    void nested_scopes_from_threads() {
+        constexpr size_t threads = 4;
+        constexpr size_t outer = 16;
+        constexpr size_t inner = 16;
+        safe::task_pool pool(4);
+
+        for (int round = 0; round < rounds; ++round) {
+            std::atomic<size_t> count = 0;
+            {
+                std::vector<std::jthread> callers;
+                for (size_t t = 0; t < threads; ++t) {
+                    callers.emplace_back([&] {
+                        pool.scope([&](safe::task_scope & scope) {
+                            for (size_t i = 0; i < outer; ++i) {
+                                scope.spawn([&] {
+                                    //a scope inside a task joins by running queued tasks on the worker itself
+                                    pool.scope([&](safe::task_scope & nested) {
+                                        for (size_t j = 0; j < inner; ++j) {
+                                            nested.spawn([&] { count.fetch_add(1, std::memory_order_relaxed); });
+                                        }
+                                    });
+                                });
+                            }
+                        });
+                    });
+                }
+            }
+            expect(count == threads * outer * inner, "tasks of nested scopes", count, threads * outer * inner);
+        }
+    }
+
+    void submit_from_threads() {
+        constexpr size_t threads = 4;
+        constexpr size_t per_thread = 10000;
+        for (int round = 0; round < rounds / 10; ++round) {
+            ran = 0;
+            {
+                safe::task_pool pool(4);
+                std::vector<std::jthread> submitters;
+                for (size_t t = 0; t < threads; ++t) {
+                    submitters.emplace_back([&pool] {
+                        for (size_t i = 0; i < per_thread; ++i) {
+                            pool.submit([] { ran.fetch_add(1, std::memory_order_relaxed); });
+                        }
+                    });
+                }
+            }
+            expect(ran == threads * per_thread, "tasks submitted from several threads", ran, threads * per_thread);
+        }
+    }
+}
+
+int main() {
+    shutdown_while_submitting();
+    nested_scopes_from_threads();
+    submit_from_threads();
+    if (failures == 0) {
+        std::print("task_pool stress test passed\n");
+    }
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}